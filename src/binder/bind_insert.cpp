@@ -13,6 +13,7 @@
 #include "binder/statement/insert_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/update_statement.h"
+#include "binder/statement/vacuum_statement.h"
 #include "binder/tokens.h"
 #include "common/exception.h"
 #include "common/util/string_util.h"
@@ -84,4 +85,21 @@ auto Binder::BindUpdate(duckdb_libpgquery::PGUpdateStmt *stmt) -> std::unique_pt
   return std::make_unique<UpdateStatement>(std::move(table), std::move(filter_expr), std::move(target_expr));
 }
 
+auto Binder::BindVacuum(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<VacuumStatement> {
+  if ((stmt->options & duckdb_libpgquery::PG_VACOPT_VACUUM) == 0) {
+    throw bustub::NotImplementedException("analyze not supported yet");
+  }
+  if (stmt->relation == nullptr) {
+    throw bustub::NotImplementedException("vacuum only supports a single table, specify the table");
+  }
+
+  auto table = BindBaseTableRef(stmt->relation->relname, std::nullopt);
+
+  if (StringUtil::StartsWith(table->table_, "__")) {
+    throw bustub::Exception(fmt::format("invalid table for vacuum: {}", table->table_));
+  }
+
+  return std::make_unique<VacuumStatement>(std::move(table));
+}
+
 }  // namespace bustub
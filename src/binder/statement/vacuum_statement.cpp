@@ -0,0 +1,11 @@
+#include "binder/statement/vacuum_statement.h"
+#include "fmt/core.h"
+
+namespace bustub {
+
+VacuumStatement::VacuumStatement(std::unique_ptr<BoundBaseTableRef> table)
+    : BoundStatement(StatementType::VACUUM_STATEMENT), table_(std::move(table)) {}
+
+auto VacuumStatement::ToString() const -> std::string { return fmt::format("BoundVacuum {{ table={} }}", *table_); }
+
+}  // namespace bustub
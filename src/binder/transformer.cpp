@@ -32,6 +32,7 @@
 #include "binder/statement/insert_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/update_statement.h"
+#include "binder/statement/vacuum_statement.h"
 #include "binder/table_ref/bound_base_table_ref.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -65,6 +66,8 @@ auto Binder::BindStatement(duckdb_libpgquery::PGNode *stmt) -> std::unique_ptr<B
       return BindDelete(reinterpret_cast<duckdb_libpgquery::PGDeleteStmt *>(stmt));
     case duckdb_libpgquery::T_PGUpdateStmt:
       return BindUpdate(reinterpret_cast<duckdb_libpgquery::PGUpdateStmt *>(stmt));
+    case duckdb_libpgquery::T_PGVacuumStmt:
+      return BindVacuum(reinterpret_cast<duckdb_libpgquery::PGVacuumStmt *>(stmt));
     case duckdb_libpgquery::T_PGIndexStmt:
       return BindIndex(reinterpret_cast<duckdb_libpgquery::PGIndexStmt *>(stmt));
     case duckdb_libpgquery::T_PGVariableSetStmt:
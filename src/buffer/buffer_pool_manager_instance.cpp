@@ -22,7 +22,7 @@ BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManag
     : pool_size_(pool_size), disk_manager_(disk_manager), log_manager_(log_manager) {
   // we allocate a consecutive memory space for the buffer pool
   pages_ = new Page[pool_size_];
-  page_table_ = new ExtendibleHashTable<page_id_t, frame_id_t>(bucket_size_);
+  page_table_ = new OpenAddressingHashTable<page_id_t, frame_id_t>(pool_size_);
   replacer_ = new LRUKReplacer(pool_size, replacer_k);
 
   // Initially, every page is in the free list.
@@ -145,9 +145,13 @@ auto BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) -> bool {
     return false;
   }
   page_table_->Remove(page_id);
-  replacer_->SetEvictable(frame_id, true);
+  // The frame goes back to the free list, so the replacer must forget it; otherwise it could be evicted while reused.
+  replacer_->Remove(frame_id);
   free_list_.emplace_back(frame_id);
   pages_[frame_id].ResetMemory();
+  pages_[frame_id].page_id_ = INVALID_PAGE_ID;
+  pages_[frame_id].is_dirty_ = false;
+  DeallocatePage(page_id);
   return true;
 }
 
@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena.cpp
+//
+// Identification: src/common/arena.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/arena.h"
+
+#include <algorithm>
+
+namespace bustub {
+
+auto Arena::NewChunk(size_t size) -> Chunk * {
+  auto chunk = std::make_unique<Chunk>();
+  chunk->data_.reset(new char[size]);
+  chunk->size_ = size;
+  reserved_bytes_.fetch_add(size, std::memory_order_relaxed);
+  chunks_.push_back(std::move(chunk));
+  return chunks_.back().get();
+}
+
+auto Arena::Allocate(size_t bytes, size_t alignment) -> void * {
+  BUSTUB_ASSERT(alignment <= ALIGNMENT, "over-aligned allocation");
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  // Chunks start max-aligned and every allocation takes a multiple of ALIGNMENT, so every allocation is aligned.
+  const size_t size = std::max<size_t>((bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1), ALIGNMENT);
+
+  // Large allocations get a chunk of their own, so that they do not waste the rest of the current chunk.
+  if (size > chunk_size_ / 4) {
+    std::scoped_lock lock(latch_);
+    return NewChunk(size)->data_.get();
+  }
+  while (true) {
+    Chunk *chunk = current_.load(std::memory_order_acquire);
+    if (chunk != nullptr) {
+      size_t offset = chunk->used_.fetch_add(size, std::memory_order_relaxed);
+      if (offset + size <= chunk->size_) {
+        return chunk->data_.get() + offset;
+      }
+    }
+    // The chunk is full (or there is none yet). Replace it, unless another thread has done so meanwhile.
+    std::scoped_lock lock(latch_);
+    if (current_.load(std::memory_order_relaxed) == chunk) {
+      current_.store(NewChunk(chunk_size_), std::memory_order_release);
+    }
+  }
+}
+
+}  // namespace bustub
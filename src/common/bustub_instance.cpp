@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <optional>
 #include <shared_mutex>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
@@ -11,6 +13,7 @@
 #include "binder/statement/index_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
+#include "binder/statement/vacuum_statement.h"
 #include "buffer/buffer_pool_manager_instance.h"
 #include "catalog/schema.h"
 #include "catalog/table_generator.h"
@@ -37,8 +40,28 @@
 
 namespace bustub {
 
+/** @return The plan tree with the runtime counters its executors recorded, one node per line */
+static auto AnalyzedPlanToString(const AbstractPlanNode &plan, const ExecutorContext &exec_ctx, size_t indent)
+    -> std::string {
+  auto node = plan.ToString(false);
+  node = node.substr(0, node.find('\n'));
+  std::vector<std::string> stats;
+  for (const auto &[name, value] : exec_ctx.GetStats(&plan)) {
+    stats.emplace_back(fmt::format("{}={}", name, value));
+  }
+  auto output = std::string(indent, ' ') + node;
+  if (!stats.empty()) {
+    output += fmt::format(" | {}", fmt::join(stats, ", "));
+  }
+  for (const auto &child : plan.GetChildren()) {
+    output += "\n" + AnalyzedPlanToString(*child, exec_ctx, indent + 2);
+  }
+  return output;
+}
+
 auto BustubInstance::MakeExecutorContext(Transaction *txn) -> std::unique_ptr<ExecutorContext> {
-  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_);
+  return std::make_unique<ExecutorContext>(txn, catalog_, buffer_pool_manager_, txn_manager_, lock_manager_,
+                                           GetQueryMemoryBudget(), GetJoinBlockSize());
 }
 
 BustubInstance::BustubInstance(const std::string &db_file_name) {
@@ -237,10 +260,22 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         }
         auto key_schema = Schema::CopySchema(&index_stmt.table_->schema_, col_ids);
 
+        // `art` is the parser's default access method when `USING` is omitted, so the adaptive radix tree is `radix`.
+        IndexType index_type;
+        if (index_stmt.index_type_ == "hash") {
+          index_type = IndexType::HashTableIndex;
+        } else if (index_stmt.index_type_ == "radix") {
+          index_type = IndexType::ArtIndex;
+        } else if (index_stmt.index_type_ == "btree" || index_stmt.index_type_ == "art") {
+          index_type = IndexType::BPlusTreeIndex;
+        } else {
+          throw NotImplementedException(fmt::format("unsupported index type {}", index_stmt.index_type_));
+        }
+
         std::unique_lock<std::shared_mutex> l(catalog_lock_);
         auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
             txn, index_stmt.index_name_, index_stmt.table_->table_, index_stmt.table_->schema_, key_schema, col_ids,
-            INTEGER_SIZE, IntegerHashFunctionType{});
+            INTEGER_SIZE, IntegerHashFunctionType{}, index_type);
         l.unlock();
 
         if (info == nullptr) {
@@ -260,6 +295,40 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         session_variables_[set_stmt.variable_] = set_stmt.value_;
         continue;
       }
+      case StatementType::VACUUM_STATEMENT: {
+        const auto &vacuum_stmt = dynamic_cast<const VacuumStatement &>(*statement);
+
+        // Moving tuples changes their rids. Queries hold the catalog lock shared until they are executed, so holding it
+        // exclusively keeps every other statement out meanwhile. The rids in the write sets of transactions that are
+        // still running must stay valid for their commit or abort, so the pages that hold them are left alone.
+        std::unique_lock<std::shared_mutex> l(catalog_lock_);
+        auto table_info = catalog_->GetTable(vacuum_stmt.table_->table_);
+        auto indexes = catalog_->GetTableIndexes(vacuum_stmt.table_->table_);
+        const auto &schema = table_info->schema_;
+        auto busy_pages = txn_manager_->GetPagesWithRunningWrites(table_info->table_.get());
+        auto on_move = [&](const Tuple &tuple, const RID &old_rid, const RID &new_rid) {
+          for (auto *index_info : indexes) {
+            auto key = tuple.KeyFromTuple(schema, index_info->key_schema_, index_info->index_->GetKeyAttrs());
+            // A unique index may hold another tuple with the same key instead of this one.
+            std::vector<RID> rids;
+            index_info->index_->ScanKey(key, &rids, txn);
+            if (std::find(rids.begin(), rids.end(), old_rid) == rids.end()) {
+              continue;
+            }
+            index_info->index_->DeleteEntry(key, old_rid, txn);
+            index_info->index_->InsertEntry(key, new_rid, txn);
+          }
+        };
+        auto stats = table_info->table_->Vacuum(txn, busy_pages, on_move);
+        l.unlock();
+
+        WriteOneCell(
+            fmt::format("Vacuumed {}: compacted_pages={}, reclaimed_bytes={}, moved_tuples={}, released_pages={}",
+                        vacuum_stmt.table_->table_, stats.compacted_pages_, stats.reclaimed_bytes_,
+                        stats.moved_tuples_, stats.released_pages_),
+            writer);
+        continue;
+      }
       case StatementType::EXPLAIN_STATEMENT: {
         const auto &explain_stmt = dynamic_cast<const ExplainStatement &>(*statement);
         std::string output;
@@ -288,11 +357,9 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
         }
 
         // Print optimizer result.
-        bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+        bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(), GetScanThreads());
         auto optimized_plan = optimizer.Optimize(planner.plan_);
 
-        l.unlock();
-
         if ((explain_stmt.options_ & ExplainOptions::OPTIMIZER) != 0) {
           output += "=== OPTIMIZER ===";
           output += "\n";
@@ -300,6 +367,23 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
           output += "\n";
         }
 
+        // Run the query and print the counters its executors recorded.
+        if ((explain_stmt.options_ & ExplainOptions::ANALYZE) != 0) {
+          auto exec_ctx = MakeExecutorContext(txn);
+          is_successful &= execution_engine_->Execute(optimized_plan, nullptr, txn, exec_ctx.get());
+          output += "=== ANALYZE ===";
+          output += "\n";
+          output += AnalyzedPlanToString(*optimized_plan, *exec_ctx, 0);
+          output += "\n";
+          const auto *arena = exec_ctx->GetArena();
+          output += fmt::format("Arena | allocations={}, bytes={}, reserved_bytes={}, chunks={}",
+                                arena->GetAllocations(), arena->GetAllocatedBytes(), arena->GetReservedBytes(),
+                                arena->GetChunks());
+          output += "\n";
+        }
+
+        l.unlock();
+
         WriteOneCell(output, writer);
 
         continue;
@@ -315,16 +399,16 @@ auto BustubInstance::ExecuteSqlTxn(const std::string &sql, ResultWriter &writer,
     planner.PlanQuery(*statement);
 
     // Optimize the query.
-    bustub::Optimizer optimizer(*catalog_, IsForceStarterRule());
+    bustub::Optimizer optimizer(*catalog_, IsForceStarterRule(), GetScanThreads());
     auto optimized_plan = optimizer.Optimize(planner.plan_);
 
-    l.unlock();
-
-    // Execute the query.
+    // Execute the query. The catalog lock stays held, so that a VACUUM cannot move tuples under the executors.
     auto exec_ctx = MakeExecutorContext(txn);
     std::vector<Tuple> result_set{};
     is_successful &= execution_engine_->Execute(optimized_plan, &result_set, txn, exec_ctx.get());
 
+    l.unlock();
+
     // Return the result set as a vector of string.
     auto schema = planner.plan_->OutputSchema();
 
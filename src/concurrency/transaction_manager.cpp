@@ -40,6 +40,10 @@ auto TransactionManager::Begin(Transaction *txn, IsolationLevel isolation_level)
 
   std::unique_lock<std::shared_mutex> l(txn_map_mutex);
   txn_map[txn->GetTransactionId()] = txn;
+  l.unlock();
+
+  std::unique_lock<std::shared_mutex> running_lock(running_txns_latch_);
+  running_txns_.insert(txn);
   return txn;
 }
 
@@ -47,6 +51,7 @@ void TransactionManager::Commit(Transaction *txn) {
   txn->SetState(TransactionState::COMMITTED);
 
   // Perform all deletes before we commit.
+  std::shared_lock<std::shared_mutex> running_lock(running_txns_latch_);
   auto write_set = txn->GetWriteSet();
   while (!write_set->empty()) {
     auto &item = write_set->back();
@@ -58,6 +63,8 @@ void TransactionManager::Commit(Transaction *txn) {
     write_set->pop_back();
   }
   write_set->clear();
+  running_lock.unlock();
+  FinishRunning(txn);
 
   // Release all the locks.
   ReleaseLocks(txn);
@@ -68,6 +75,7 @@ void TransactionManager::Commit(Transaction *txn) {
 void TransactionManager::Abort(Transaction *txn) {
   txn->SetState(TransactionState::ABORTED);
   // Rollback before releasing the lock.
+  std::shared_lock<std::shared_mutex> running_lock(running_txns_latch_);
   auto table_write_set = txn->GetWriteSet();
   while (!table_write_set->empty()) {
     auto &item = table_write_set->back();
@@ -108,6 +116,8 @@ void TransactionManager::Abort(Transaction *txn) {
   }
   table_write_set->clear();
   index_write_set->clear();
+  running_lock.unlock();
+  FinishRunning(txn);
 
   // Release all the locks.
   ReleaseLocks(txn);
@@ -115,6 +125,25 @@ void TransactionManager::Abort(Transaction *txn) {
   global_txn_latch_.RUnlock();
 }
 
+auto TransactionManager::GetPagesWithRunningWrites(const TableHeap *table) -> std::unordered_set<page_id_t> {
+  // Exclusively, so that no commit or abort changes a write set while it is read.
+  std::unique_lock<std::shared_mutex> l(running_txns_latch_);
+  std::unordered_set<page_id_t> page_ids;
+  for (auto *txn : running_txns_) {
+    for (const auto &record : *txn->GetWriteSet()) {
+      if (record.table_ == table) {
+        page_ids.insert(record.rid_.GetPageId());
+      }
+    }
+  }
+  return page_ids;
+}
+
+void TransactionManager::FinishRunning(Transaction *txn) {
+  std::unique_lock<std::shared_mutex> l(running_txns_latch_);
+  running_txns_.erase(txn);
+}
+
 void TransactionManager::BlockAllTransactions() { global_txn_latch_.WLock(); }
 
 void TransactionManager::ResumeTransactions() { global_txn_latch_.WUnlock(); }
@@ -0,0 +1,686 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree.cpp
+//
+// Identification: src/container/art/adaptive_radix_tree.cpp
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <thread>  // NOLINT
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/rid.h"
+#include "container/art/adaptive_radix_tree.h"
+
+namespace bustub {
+
+template <typename V>
+auto AdaptiveRadixTree<V>::Leaf::KeyEquals(const uint8_t *key, size_t key_len) const -> bool {
+  return key_.size() == key_len && memcmp(key_.data(), key, key_len) == 0;
+}
+
+template <typename V>
+AdaptiveRadixTree<V>::Node48::Node48() : InnerNode(NodeType::Node48) {
+  memset(child_index_, EMPTY_INDEX, sizeof(child_index_));
+}
+
+template <typename V>
+AdaptiveRadixTree<V>::AdaptiveRadixTree() : root_(new Node256()) {}
+
+template <typename V>
+AdaptiveRadixTree<V>::~AdaptiveRadixTree() {
+  FreeSubtree(root_);
+  for (auto *node : garbage_) {
+    FreeNode(node);
+  }
+}
+
+/*****************************************************************************
+ * OPTIMISTIC LOCK COUPLING
+ *****************************************************************************/
+template <typename V>
+auto AdaptiveRadixTree<V>::ReadLockOrRestart(InnerNode *node, uint64_t *version) -> bool {
+  uint64_t current = node->version_.load();
+  if ((current & 0b11) != 0) {
+    // Locked or obsolete: give the writer a chance to finish before the restart.
+    std::this_thread::yield();
+    return false;
+  }
+  *version = current;
+  return true;
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::CheckOrRestart(InnerNode *node, uint64_t version) -> bool {
+  return node->version_.load() == version;
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::UpgradeToWriteLockOrRestart(InnerNode *node, uint64_t version) -> bool {
+  return node->version_.compare_exchange_strong(version, version + 0b10);
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::WriteUnlock(InnerNode *node) {
+  // Clears the lock bit and bumps the version counter.
+  node->version_.fetch_add(0b10);
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::WriteUnlockObsolete(InnerNode *node) {
+  node->version_.fetch_add(0b11);
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::Retire(Node *node) {
+  std::scoped_lock lock(garbage_latch_);
+  garbage_.push_back(node);
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::LeaveOperation() {
+  if (--active_ops_ != 0) {
+    return;
+  }
+  // Every retired node was unlinked before it was retired, so once no operation is running nobody can reach it.
+  std::vector<Node *> garbage;
+  {
+    std::scoped_lock lock(garbage_latch_);
+    if (garbage_.empty() || active_ops_.load() != 0) {
+      return;
+    }
+    garbage.swap(garbage_);
+  }
+  for (auto *node : garbage) {
+    FreeNode(node);
+  }
+}
+
+/*****************************************************************************
+ * NODE OPERATIONS
+ *****************************************************************************/
+template <typename V>
+auto AdaptiveRadixTree<V>::FindChild(InnerNode *node, uint8_t byte) -> Node * {
+  // Readers may see a node while it is being modified; bound every index so that a torn read stays in range. The
+  // version check afterwards throws the result away.
+  switch (node->type_) {
+    case NodeType::Node4: {
+      auto *n = static_cast<Node4 *>(node);
+      size_t num = std::min<size_t>(n->num_children_, 4);
+      for (size_t i = 0; i < num; i++) {
+        if (n->keys_[i] == byte) {
+          return n->children_[i].load();
+        }
+      }
+      return nullptr;
+    }
+    case NodeType::Node16: {
+      auto *n = static_cast<Node16 *>(node);
+      size_t num = std::min<size_t>(n->num_children_, 16);
+#if defined(__SSE2__)
+      __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys_)));
+      auto bitfield = static_cast<unsigned>(_mm_movemask_epi8(cmp)) & ((1U << num) - 1);
+      if (bitfield != 0) {
+        return n->children_[__builtin_ctz(bitfield)].load();
+      }
+#else
+      for (size_t i = 0; i < num; i++) {
+        if (n->keys_[i] == byte) {
+          return n->children_[i].load();
+        }
+      }
+#endif
+      return nullptr;
+    }
+    case NodeType::Node48: {
+      auto *n = static_cast<Node48 *>(node);
+      uint8_t idx = n->child_index_[byte];
+      return idx < Node48::EMPTY_INDEX ? n->children_[idx].load() : nullptr;
+    }
+    case NodeType::Node256:
+      return static_cast<Node256 *>(node)->children_[byte].load();
+    default:
+      UNREACHABLE("not an inner node");
+  }
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::IsFull(InnerNode *node) -> bool {
+  switch (node->type_) {
+    case NodeType::Node4:
+      return node->num_children_ == 4;
+    case NodeType::Node16:
+      return node->num_children_ == 16;
+    case NodeType::Node48:
+      return node->num_children_ == 48;
+    default:
+      return false;
+  }
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::AddChild(InnerNode *node, uint8_t byte, Node *child) {
+  switch (node->type_) {
+    case NodeType::Node4: {
+      auto *n = static_cast<Node4 *>(node);
+      n->keys_[n->num_children_] = byte;
+      n->children_[n->num_children_].store(child);
+      break;
+    }
+    case NodeType::Node16: {
+      auto *n = static_cast<Node16 *>(node);
+      n->keys_[n->num_children_] = byte;
+      n->children_[n->num_children_].store(child);
+      break;
+    }
+    case NodeType::Node48: {
+      auto *n = static_cast<Node48 *>(node);
+      uint8_t slot = 0;
+      while (n->children_[slot].load() != nullptr) {
+        slot++;
+      }
+      n->children_[slot].store(child);
+      n->child_index_[byte] = slot;
+      break;
+    }
+    case NodeType::Node256:
+      static_cast<Node256 *>(node)->children_[byte].store(child);
+      break;
+    default:
+      UNREACHABLE("not an inner node");
+  }
+  node->num_children_++;
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::ReplaceChild(InnerNode *node, uint8_t byte, Node *child) {
+  switch (node->type_) {
+    case NodeType::Node4: {
+      auto *n = static_cast<Node4 *>(node);
+      for (size_t i = 0; i < n->num_children_; i++) {
+        if (n->keys_[i] == byte) {
+          n->children_[i].store(child);
+          return;
+        }
+      }
+      break;
+    }
+    case NodeType::Node16: {
+      auto *n = static_cast<Node16 *>(node);
+      for (size_t i = 0; i < n->num_children_; i++) {
+        if (n->keys_[i] == byte) {
+          n->children_[i].store(child);
+          return;
+        }
+      }
+      break;
+    }
+    case NodeType::Node48: {
+      auto *n = static_cast<Node48 *>(node);
+      n->children_[n->child_index_[byte]].store(child);
+      return;
+    }
+    case NodeType::Node256:
+      static_cast<Node256 *>(node)->children_[byte].store(child);
+      return;
+    default:
+      break;
+  }
+  UNREACHABLE("child to replace does not exist");
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::RemoveChild(InnerNode *node, uint8_t byte) {
+  switch (node->type_) {
+    case NodeType::Node4:
+    case NodeType::Node16: {
+      uint8_t *keys;
+      std::atomic<Node *> *children;
+      if (node->type_ == NodeType::Node4) {
+        keys = static_cast<Node4 *>(node)->keys_;
+        children = static_cast<Node4 *>(node)->children_;
+      } else {
+        keys = static_cast<Node16 *>(node)->keys_;
+        children = static_cast<Node16 *>(node)->children_;
+      }
+      // Children are unordered, so the last one fills the gap.
+      size_t last = node->num_children_ - 1;
+      for (size_t i = 0; i <= last; i++) {
+        if (keys[i] == byte) {
+          keys[i] = keys[last];
+          children[i].store(children[last].load());
+          children[last].store(nullptr);
+          break;
+        }
+      }
+      break;
+    }
+    case NodeType::Node48: {
+      auto *n = static_cast<Node48 *>(node);
+      n->children_[n->child_index_[byte]].store(nullptr);
+      n->child_index_[byte] = Node48::EMPTY_INDEX;
+      break;
+    }
+    case NodeType::Node256:
+      static_cast<Node256 *>(node)->children_[byte].store(nullptr);
+      break;
+    default:
+      UNREACHABLE("not an inner node");
+  }
+  node->num_children_--;
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::Grow(InnerNode *node) -> InnerNode * {
+  InnerNode *bigger;
+  switch (node->type_) {
+    case NodeType::Node4: {
+      auto *n = static_cast<Node4 *>(node);
+      auto *grown = new Node16();
+      for (size_t i = 0; i < n->num_children_; i++) {
+        grown->keys_[i] = n->keys_[i];
+        grown->children_[i].store(n->children_[i].load());
+      }
+      bigger = grown;
+      break;
+    }
+    case NodeType::Node16: {
+      auto *n = static_cast<Node16 *>(node);
+      auto *grown = new Node48();
+      for (size_t i = 0; i < n->num_children_; i++) {
+        grown->child_index_[n->keys_[i]] = static_cast<uint8_t>(i);
+        grown->children_[i].store(n->children_[i].load());
+      }
+      bigger = grown;
+      break;
+    }
+    case NodeType::Node48: {
+      auto *n = static_cast<Node48 *>(node);
+      auto *grown = new Node256();
+      for (size_t byte = 0; byte < 256; byte++) {
+        if (n->child_index_[byte] != Node48::EMPTY_INDEX) {
+          grown->children_[byte].store(n->children_[n->child_index_[byte]].load());
+        }
+      }
+      bigger = grown;
+      break;
+    }
+    default:
+      UNREACHABLE("Node256 never grows");
+  }
+  bigger->num_children_ = node->num_children_;
+  bigger->prefix_len_ = node->prefix_len_;
+  memcpy(bigger->prefix_, node->prefix_, node->prefix_len_);
+  return bigger;
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::MakeBranch(Leaf *old_leaf, Leaf *new_leaf, size_t depth) -> InnerNode * {
+  const auto &old_key = old_leaf->key_;
+  const auto &new_key = new_leaf->key_;
+  size_t common = 0;
+  while (depth + common < old_key.size() && depth + common < new_key.size() &&
+         old_key[depth + common] == new_key[depth + common]) {
+    common++;
+  }
+  BUSTUB_ASSERT(depth + common < old_key.size() && depth + common < new_key.size(), "keys must be prefix-free");
+
+  auto *node = new Node4();
+  node->prefix_len_ = static_cast<uint8_t>(std::min(common, MAX_PREFIX_LEN));
+  memcpy(node->prefix_, new_key.data() + depth, node->prefix_len_);
+  if (common > MAX_PREFIX_LEN) {
+    // The shared run does not fit into one prefix, continue it in a child.
+    AddChild(node, new_key[depth + MAX_PREFIX_LEN], MakeBranch(old_leaf, new_leaf, depth + MAX_PREFIX_LEN + 1));
+  } else {
+    AddChild(node, old_key[depth + common], old_leaf);
+    AddChild(node, new_key[depth + common], new_leaf);
+  }
+  return node;
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::FreeNode(Node *node) {
+  switch (node->type_) {
+    case NodeType::Node4:
+      delete static_cast<Node4 *>(node);
+      break;
+    case NodeType::Node16:
+      delete static_cast<Node16 *>(node);
+      break;
+    case NodeType::Node48:
+      delete static_cast<Node48 *>(node);
+      break;
+    case NodeType::Node256:
+      delete static_cast<Node256 *>(node);
+      break;
+    case NodeType::Leaf:
+      delete static_cast<Leaf *>(node);
+      break;
+  }
+}
+
+template <typename V>
+void AdaptiveRadixTree<V>::FreeSubtree(Node *node) {
+  switch (node->type_) {
+    case NodeType::Node4: {
+      auto *n = static_cast<Node4 *>(node);
+      for (size_t i = 0; i < n->num_children_; i++) {
+        FreeSubtree(n->children_[i].load());
+      }
+      break;
+    }
+    case NodeType::Node16: {
+      auto *n = static_cast<Node16 *>(node);
+      for (size_t i = 0; i < n->num_children_; i++) {
+        FreeSubtree(n->children_[i].load());
+      }
+      break;
+    }
+    case NodeType::Node48:
+      for (auto &child : static_cast<Node48 *>(node)->children_) {
+        if (child.load() != nullptr) {
+          FreeSubtree(child.load());
+        }
+      }
+      break;
+    case NodeType::Node256:
+      for (auto &child : static_cast<Node256 *>(node)->children_) {
+        if (child.load() != nullptr) {
+          FreeSubtree(child.load());
+        }
+      }
+      break;
+    case NodeType::Leaf:
+      break;
+  }
+  FreeNode(node);
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+template <typename V>
+auto AdaptiveRadixTree<V>::GetValue(const uint8_t *key, size_t key_len, std::vector<V> *result) -> bool {
+  OperationGuard guard(this);
+  while (true) {
+    if (auto found = TryGetValue(key, key_len, result); found.has_value()) {
+      return *found;
+    }
+  }
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::TryGetValue(const uint8_t *key, size_t key_len, std::vector<V> *result)
+    -> std::optional<bool> {
+  InnerNode *node = root_;
+  uint64_t version;
+  if (!ReadLockOrRestart(node, &version)) {
+    return std::nullopt;
+  }
+  size_t depth = 0;
+  while (true) {
+    // Compare the compressed path. A torn read is caught by the version check below.
+    size_t prefix_len = std::min<size_t>(node->prefix_len_, MAX_PREFIX_LEN);
+    bool match = depth + prefix_len < key_len && memcmp(node->prefix_, key + depth, prefix_len) == 0;
+    depth += prefix_len;
+    Node *child = match ? FindChild(node, key[depth]) : nullptr;
+    if (!CheckOrRestart(node, version)) {
+      return std::nullopt;
+    }
+    if (child == nullptr) {
+      return false;
+    }
+
+    if (child->type_ == NodeType::Leaf) {
+      // Leaves never change once published, and retired ones outlive this operation.
+      auto *leaf = static_cast<Leaf *>(child);
+      if (!leaf->KeyEquals(key, key_len)) {
+        return false;
+      }
+      result->insert(result->end(), leaf->values_.begin(), leaf->values_.end());
+      return true;
+    }
+
+    auto *next = static_cast<InnerNode *>(child);
+    uint64_t next_version;
+    if (!ReadLockOrRestart(next, &next_version) || !CheckOrRestart(node, version)) {
+      return std::nullopt;
+    }
+    node = next;
+    version = next_version;
+    depth++;
+  }
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+template <typename V>
+auto AdaptiveRadixTree<V>::Insert(const uint8_t *key, size_t key_len, const V &value) -> bool {
+  OperationGuard guard(this);
+  while (true) {
+    if (auto inserted = TryInsert(key, key_len, value); inserted.has_value()) {
+      return *inserted;
+    }
+  }
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::TryInsert(const uint8_t *key, size_t key_len, const V &value) -> std::optional<bool> {
+  InnerNode *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_byte = 0;
+  InnerNode *node = root_;
+  uint64_t version;
+  if (!ReadLockOrRestart(node, &version)) {
+    return std::nullopt;
+  }
+  size_t depth = 0;
+  while (true) {
+    size_t prefix_len = std::min<size_t>(node->prefix_len_, MAX_PREFIX_LEN);
+    size_t mismatch = 0;
+    while (mismatch < prefix_len && depth + mismatch < key_len && node->prefix_[mismatch] == key[depth + mismatch]) {
+      mismatch++;
+    }
+
+    if (mismatch < prefix_len) {
+      // The key leaves the compressed path: put a Node4 with the shared part of the prefix above the node. The root
+      // has no prefix, so there always is a parent here.
+      if (!UpgradeToWriteLockOrRestart(parent, parent_version)) {
+        return std::nullopt;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        WriteUnlock(parent);
+        return std::nullopt;
+      }
+      BUSTUB_ASSERT(depth + mismatch < key_len, "keys must be prefix-free");
+      auto *branch = new Node4();
+      branch->prefix_len_ = static_cast<uint8_t>(mismatch);
+      memcpy(branch->prefix_, node->prefix_, mismatch);
+      auto *leaf = new Leaf(key, key_len);
+      leaf->values_.push_back(value);
+      AddChild(branch, key[depth + mismatch], leaf);
+      AddChild(branch, node->prefix_[mismatch], node);
+
+      node->prefix_len_ -= mismatch + 1;
+      memmove(node->prefix_, node->prefix_ + mismatch + 1, node->prefix_len_);
+      ReplaceChild(parent, parent_byte, branch);
+      WriteUnlock(node);
+      WriteUnlock(parent);
+      return true;
+    }
+
+    depth += prefix_len;
+    if (depth >= key_len) {
+      if (!CheckOrRestart(node, version)) {
+        return std::nullopt;
+      }
+      UNREACHABLE("keys must be prefix-free");
+    }
+    uint8_t byte = key[depth];
+    Node *child = FindChild(node, byte);
+    if (!CheckOrRestart(node, version)) {
+      return std::nullopt;
+    }
+
+    if (child == nullptr) {
+      auto *leaf = new Leaf(key, key_len);
+      leaf->values_.push_back(value);
+      if (IsFull(node)) {
+        // Full nodes are replaced by a larger copy; the root is a Node256 and never full.
+        if (!UpgradeToWriteLockOrRestart(parent, parent_version)) {
+          delete leaf;
+          return std::nullopt;
+        }
+        if (!UpgradeToWriteLockOrRestart(node, version)) {
+          WriteUnlock(parent);
+          delete leaf;
+          return std::nullopt;
+        }
+        InnerNode *bigger = Grow(node);
+        AddChild(bigger, byte, leaf);
+        ReplaceChild(parent, parent_byte, bigger);
+        WriteUnlockObsolete(node);
+        WriteUnlock(parent);
+        Retire(node);
+        return true;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        delete leaf;
+        return std::nullopt;
+      }
+      if (parent != nullptr && !CheckOrRestart(parent, parent_version)) {
+        WriteUnlock(node);
+        delete leaf;
+        return std::nullopt;
+      }
+      AddChild(node, byte, leaf);
+      WriteUnlock(node);
+      return true;
+    }
+
+    if (child->type_ == NodeType::Leaf) {
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        return std::nullopt;
+      }
+      auto *old_leaf = static_cast<Leaf *>(child);
+      if (old_leaf->KeyEquals(key, key_len)) {
+        if (std::find(old_leaf->values_.begin(), old_leaf->values_.end(), value) != old_leaf->values_.end()) {
+          WriteUnlock(node);
+          return false;
+        }
+        // Leaves are copy-on-write so that readers never see a half-updated value list.
+        auto *new_leaf = new Leaf(key, key_len);
+        new_leaf->values_ = old_leaf->values_;
+        new_leaf->values_.push_back(value);
+        ReplaceChild(node, byte, new_leaf);
+        WriteUnlock(node);
+        Retire(old_leaf);
+        return true;
+      }
+      auto *new_leaf = new Leaf(key, key_len);
+      new_leaf->values_.push_back(value);
+      ReplaceChild(node, byte, MakeBranch(old_leaf, new_leaf, depth + 1));
+      WriteUnlock(node);
+      return true;
+    }
+
+    if (parent != nullptr && !CheckOrRestart(parent, parent_version)) {
+      return std::nullopt;
+    }
+    parent = node;
+    parent_version = version;
+    parent_byte = byte;
+    node = static_cast<InnerNode *>(child);
+    if (!ReadLockOrRestart(node, &version) || !CheckOrRestart(parent, parent_version)) {
+      return std::nullopt;
+    }
+    depth++;
+  }
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+template <typename V>
+auto AdaptiveRadixTree<V>::Remove(const uint8_t *key, size_t key_len, const V &value) -> bool {
+  OperationGuard guard(this);
+  while (true) {
+    if (auto removed = TryRemove(key, key_len, value); removed.has_value()) {
+      return *removed;
+    }
+  }
+}
+
+template <typename V>
+auto AdaptiveRadixTree<V>::TryRemove(const uint8_t *key, size_t key_len, const V &value) -> std::optional<bool> {
+  InnerNode *node = root_;
+  uint64_t version;
+  if (!ReadLockOrRestart(node, &version)) {
+    return std::nullopt;
+  }
+  size_t depth = 0;
+  while (true) {
+    size_t prefix_len = std::min<size_t>(node->prefix_len_, MAX_PREFIX_LEN);
+    bool match = depth + prefix_len < key_len && memcmp(node->prefix_, key + depth, prefix_len) == 0;
+    depth += prefix_len;
+    uint8_t byte = match ? key[depth] : 0;
+    Node *child = match ? FindChild(node, byte) : nullptr;
+    if (!CheckOrRestart(node, version)) {
+      return std::nullopt;
+    }
+    if (child == nullptr) {
+      return false;
+    }
+
+    if (child->type_ == NodeType::Leaf) {
+      auto *leaf = static_cast<Leaf *>(child);
+      if (!leaf->KeyEquals(key, key_len)) {
+        return false;
+      }
+      auto it = std::find(leaf->values_.begin(), leaf->values_.end(), value);
+      if (it == leaf->values_.end()) {
+        return false;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        return std::nullopt;
+      }
+      if (leaf->values_.size() == 1) {
+        RemoveChild(node, byte);
+      } else {
+        auto *new_leaf = new Leaf(key, key_len);
+        new_leaf->values_ = leaf->values_;
+        new_leaf->values_.erase(new_leaf->values_.begin() + (it - leaf->values_.begin()));
+        ReplaceChild(node, byte, new_leaf);
+      }
+      WriteUnlock(node);
+      Retire(leaf);
+      return true;
+    }
+
+    auto *next = static_cast<InnerNode *>(child);
+    uint64_t next_version;
+    if (!ReadLockOrRestart(next, &next_version) || !CheckOrRestart(node, version)) {
+      return std::nullopt;
+    }
+    node = next;
+    version = next_version;
+    depth++;
+  }
+}
+
+template class AdaptiveRadixTree<RID>;
+// test purpose
+template class AdaptiveRadixTree<int64_t>;
+
+}  // namespace bustub
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -26,7 +27,20 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                          const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
     : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+  // Start with global depth 0: a directory with a single slot pointing at one empty bucket.
+  Page *page = buffer_pool_manager_->NewPage(&directory_page_id_, nullptr);
+  BUSTUB_ASSERT(page != nullptr, "cannot allocate the hash table directory page");
+  auto dir_page = reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
+  dir_page->SetPageId(directory_page_id_);
+
+  page_id_t bucket_page_id = INVALID_PAGE_ID;
+  Page *bucket_page = buffer_pool_manager_->NewPage(&bucket_page_id, nullptr);
+  BUSTUB_ASSERT(bucket_page != nullptr, "cannot allocate the first hash table bucket page");
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true, nullptr);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true, nullptr);
 }
 
 /*****************************************************************************
@@ -46,22 +60,30 @@ auto HASH_TABLE_TYPE::Hash(KeyType key) -> uint32_t {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t {
-  return 0;
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t {
-  return 0;
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchDirectoryPage() -> HashTableDirectoryPage * {
-  return nullptr;
+  Page *page = buffer_pool_manager_->FetchPage(directory_page_id_);
+  if (page == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<HashTableDirectoryPage *>(page->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
-  return nullptr;
+  Page *page = buffer_pool_manager_->FetchPage(bucket_page_id);
+  if (page == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
 }
 
 /*****************************************************************************
@@ -69,7 +91,30 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    return false;
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+  if (bucket_page == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+    table_latch_.RUnlock();
+    return false;
+  }
+
+  // The bucket page starts at the beginning of its frame, so the frame's latch can be reached from it.
+  auto page = reinterpret_cast<Page *>(bucket_page);
+  page->RLatch();
+  bool found = bucket_page->GetValue(key, comparator_, result);
+  page->RUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
@@ -77,12 +122,121 @@ auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    return false;
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+  if (bucket_page == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+    table_latch_.RUnlock();
+    return false;
+  }
+
+  auto page = reinterpret_cast<Page *>(bucket_page);
+  page->WLatch();
+  if (!bucket_page->IsFull()) {
+    bool inserted = bucket_page->Insert(key, value, comparator_);
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, inserted, nullptr);
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+    table_latch_.RUnlock();
+    return inserted;
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+  table_latch_.RUnlock();
+
+  // The bucket is full; retry under the table write latch so that it can be split.
+  return SplitInsert(transaction, key, value);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.WUnlock();
+    return false;
+  }
+  bool dir_dirty = false;
+  bool inserted = false;
+
+  while (true) {
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+    if (bucket_page == nullptr) {
+      break;
+    }
+
+    if (!bucket_page->IsFull()) {
+      inserted = bucket_page->Insert(key, value, comparator_);
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted, nullptr);
+      break;
+    }
+
+    // A full bucket may already hold the exact pair; splitting would not help then.
+    std::vector<ValueType> existing;
+    bucket_page->GetValue(key, comparator_, &existing);
+    bool is_duplicate = std::find(existing.begin(), existing.end(), value) != existing.end();
+
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (is_duplicate ||
+        (local_depth == dir_page->GetGlobalDepth() && dir_page->Size() * 2 > DIRECTORY_ARRAY_SIZE)) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+      break;
+    }
+
+    // Without a page for the split image the insert fails; nothing has been changed yet.
+    page_id_t image_page_id = INVALID_PAGE_ID;
+    Page *new_page = buffer_pool_manager_->NewPage(&image_page_id, nullptr);
+    if (new_page == nullptr) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+      break;
+    }
+    auto image_page = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(new_page->GetData());
+
+    if (local_depth == dir_page->GetGlobalDepth()) {
+      dir_page->IncrGlobalDepth();
+    }
+    dir_dirty = true;
+
+    // Every slot that pointed at the full bucket gains one bit of local depth; the slots whose new bit is set now
+    // point at the split image.
+    uint32_t high_bit = 1U << local_depth;
+    for (uint32_t i = 0; i < dir_page->Size(); i++) {
+      if (dir_page->GetBucketPageId(i) != bucket_page_id) {
+        continue;
+      }
+      dir_page->IncrLocalDepth(i);
+      if ((i & high_bit) != 0) {
+        dir_page->SetBucketPageId(i, image_page_id);
+      }
+    }
+
+    for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE; slot++) {
+      if (!bucket_page->IsReadable(slot)) {
+        continue;
+      }
+      KeyType slot_key = bucket_page->KeyAt(slot);
+      if ((Hash(slot_key) & high_bit) != 0) {
+        image_page->Insert(slot_key, bucket_page->ValueAt(slot), comparator_);
+        bucket_page->RemoveAt(slot);
+      }
+    }
+
+    buffer_pool_manager_->UnpinPage(image_page_id, true, nullptr);
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true, nullptr);
+  }
+
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty, nullptr);
+  table_latch_.WUnlock();
+  return inserted;
 }
 
 /*****************************************************************************
@@ -90,14 +244,102 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    table_latch_.RUnlock();
+    return false;
+  }
+  page_id_t bucket_page_id = KeyToPageId(key, dir_page);
+  HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+  if (bucket_page == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+    table_latch_.RUnlock();
+    return false;
+  }
+
+  auto page = reinterpret_cast<Page *>(bucket_page);
+  page->WLatch();
+  bool removed = bucket_page->Remove(key, value, comparator_);
+  bool is_empty = bucket_page->IsEmpty();
+  page->WUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, removed, nullptr);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false, nullptr);
+  table_latch_.RUnlock();
+
+  if (removed && is_empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  if (dir_page == nullptr) {
+    // The bucket stays empty; a later remove from it merges it.
+    table_latch_.WUnlock();
+    return;
+  }
+  bool dir_dirty = false;
+
+  // Keep folding the key's bucket and its split image together for as long as one of the two is empty.
+  while (true) {
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (local_depth == 0) {
+      break;
+    }
+    uint32_t image_idx = bucket_idx ^ (1U << (local_depth - 1));
+    if (dir_page->GetLocalDepth(image_idx) != local_depth) {
+      break;
+    }
+
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+    HASH_TABLE_BUCKET_TYPE *bucket_page = FetchBucketPage(bucket_page_id);
+    if (bucket_page == nullptr) {
+      break;
+    }
+    bool is_empty = bucket_page->IsEmpty();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false, nullptr);
+    if (!is_empty) {
+      // The image may have been left empty by an earlier remove that could not merge yet.
+      HASH_TABLE_BUCKET_TYPE *image_page = FetchBucketPage(image_page_id);
+      if (image_page == nullptr) {
+        break;
+      }
+      bool image_is_empty = image_page->IsEmpty();
+      buffer_pool_manager_->UnpinPage(image_page_id, false, nullptr);
+      if (!image_is_empty) {
+        break;
+      }
+      std::swap(bucket_page_id, image_page_id);
+    }
+
+    for (uint32_t i = 0; i < dir_page->Size(); i++) {
+      page_id_t page_id = dir_page->GetBucketPageId(i);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir_page->SetBucketPageId(i, image_page_id);
+        dir_page->DecrLocalDepth(i);
+      }
+    }
+    buffer_pool_manager_->DeletePage(bucket_page_id, nullptr);
+    dir_dirty = true;
+
+    while (dir_page->CanShrink()) {
+      dir_page->DecrGlobalDepth();
+    }
+  }
+
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty, nullptr);
+  table_latch_.WUnlock();
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
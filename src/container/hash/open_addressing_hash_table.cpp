@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// open_addressing_hash_table.cpp
+//
+// Identification: src/container/hash/open_addressing_hash_table.cpp
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "common/util/hash_util.h"
+#include "container/hash/open_addressing_hash_table.h"
+
+namespace bustub {
+
+template <typename K, typename V>
+OpenAddressingHashTable<K, V>::OpenAddressingHashTable(size_t capacity, size_t num_stripes) {
+  // At least two stripes, so that the stripe shift below stays under 64.
+  size_t stripe_bits = 1;
+  while ((static_cast<size_t>(1) << stripe_bits) < num_stripes) {
+    stripe_bits++;
+  }
+  BUSTUB_ASSERT(stripe_bits < 32, "too many stripes");
+  stripe_shift_ = 64 - stripe_bits;
+  stripes_ = std::vector<Stripe>(static_cast<size_t>(1) << stripe_bits);
+
+  // Size every stripe so that its share of `capacity` stays under the load limit.
+  size_t per_stripe = capacity / stripes_.size() * MAX_LOAD_DEN / MAX_LOAD_NUM + 1;
+  size_t stripe_capacity = 8;
+  while (stripe_capacity < per_stripe) {
+    stripe_capacity <<= 1;
+  }
+  for (auto &stripe : stripes_) {
+    stripe.slots_.resize(stripe_capacity);
+  }
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::HashOf(const K &key) -> uint64_t {
+  return HashUtil::MixHash(std::hash<K>()(key));
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::StripeOf(uint64_t hash) -> Stripe & {
+  return stripes_[hash >> stripe_shift_];
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::Probe(const std::vector<Slot> &slots, const K &key, uint64_t hash) -> size_t {
+  size_t mask = slots.size() - 1;
+  size_t idx = hash & mask;
+  while (slots[idx].occupied_ && !(slots[idx].key_ == key)) {
+    idx = (idx + 1) & mask;
+  }
+  return idx;
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::Find(const K &key, V &value) -> bool {
+  uint64_t hash = HashOf(key);
+  Stripe &stripe = StripeOf(hash);
+  stripe.latch_.RLock();
+  size_t idx = Probe(stripe.slots_, key, hash);
+  bool found = stripe.slots_[idx].occupied_;
+  if (found) {
+    value = stripe.slots_[idx].value_;
+  }
+  stripe.latch_.RUnlock();
+  return found;
+}
+
+template <typename K, typename V>
+void OpenAddressingHashTable<K, V>::Insert(const K &key, const V &value) {
+  uint64_t hash = HashOf(key);
+  Stripe &stripe = StripeOf(hash);
+  stripe.latch_.WLock();
+  size_t idx = Probe(stripe.slots_, key, hash);
+  if (stripe.slots_[idx].occupied_) {
+    stripe.slots_[idx].value_ = value;
+    stripe.latch_.WUnlock();
+    return;
+  }
+  if ((stripe.size_ + 1) * MAX_LOAD_DEN > stripe.slots_.size() * MAX_LOAD_NUM) {
+    Grow(&stripe);
+    idx = Probe(stripe.slots_, key, hash);
+  }
+  Slot &slot = stripe.slots_[idx];
+  slot.key_ = key;
+  slot.value_ = value;
+  slot.occupied_ = true;
+  stripe.size_++;
+  stripe.latch_.WUnlock();
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::Remove(const K &key) -> bool {
+  uint64_t hash = HashOf(key);
+  Stripe &stripe = StripeOf(hash);
+  stripe.latch_.WLock();
+  auto &slots = stripe.slots_;
+  size_t mask = slots.size() - 1;
+  size_t hole = Probe(slots, key, hash);
+  if (!slots[hole].occupied_) {
+    stripe.latch_.WUnlock();
+    return false;
+  }
+
+  // Backward-shift deletion: pull later entries of the cluster into the hole unless that would move them in front
+  // of their home slot.
+  size_t next = (hole + 1) & mask;
+  while (slots[next].occupied_) {
+    size_t home = HashOf(slots[next].key_) & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      slots[hole] = std::move(slots[next]);
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+  slots[hole].occupied_ = false;
+  slots[hole].value_ = V();
+  stripe.size_--;
+  stripe.latch_.WUnlock();
+  return true;
+}
+
+template <typename K, typename V>
+void OpenAddressingHashTable<K, V>::Grow(Stripe *stripe) {
+  std::vector<Slot> slots(stripe->slots_.size() * 2);
+  for (auto &slot : stripe->slots_) {
+    if (slot.occupied_) {
+      size_t idx = Probe(slots, slot.key_, HashOf(slot.key_));
+      slots[idx] = std::move(slot);
+    }
+  }
+  stripe->slots_ = std::move(slots);
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::Size() const -> size_t {
+  size_t size = 0;
+  for (const auto &stripe : stripes_) {
+    stripe.latch_.RLock();
+    size += stripe.size_;
+    stripe.latch_.RUnlock();
+  }
+  return size;
+}
+
+template <typename K, typename V>
+auto OpenAddressingHashTable<K, V>::GetCapacity() const -> size_t {
+  size_t capacity = 0;
+  for (const auto &stripe : stripes_) {
+    stripe.latch_.RLock();
+    capacity += stripe.slots_.size();
+    stripe.latch_.RUnlock();
+  }
+  return capacity;
+}
+
+template class OpenAddressingHashTable<page_id_t, frame_id_t>;
+// test purpose
+template class OpenAddressingHashTable<int, std::string>;
+
+}  // namespace bustub
@@ -9,13 +9,50 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
 #include <vector>
 
 #include "execution/executors/aggregation_executor.h"
 
 namespace bustub {
 
+auto FlatAggregationTable::FindOrInsert(hash_t hash, AggregateKey &&key, const AggregateValue &initial)
+    -> AggregateValue * {
+  // Keep the table at most half full.
+  if ((groups_.size() + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  for (hash_t slot = hash & mask_;; slot = (slot + 1) & mask_) {
+    uint32_t idx = slots_[slot];
+    if (idx == 0) {
+      slots_[slot] = static_cast<uint32_t>(groups_.size() + 1);
+      groups_.push_back({hash, std::move(key), initial});
+      return &groups_.back().value_;
+    }
+    auto &group = groups_[idx - 1];
+    if (group.hash_ == hash && group.key_ == key) {
+      return &group.value_;
+    }
+  }
+}
+
+void FlatAggregationTable::Grow() {
+  slots_.assign(std::max<size_t>(slots_.size() * 2, 16), 0);
+  mask_ = slots_.size() - 1;
+  for (size_t i = 0; i < groups_.size(); i++) {
+    hash_t slot = groups_[i].hash_ & mask_;
+    while (slots_[slot] != 0) {
+      slot = (slot + 1) & mask_;
+    }
+    slots_[slot] = static_cast<uint32_t>(i + 1);
+  }
+}
+
 AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
                                          std::unique_ptr<AbstractExecutor> &&child)
     : AbstractExecutor(exec_ctx),
@@ -26,18 +63,191 @@ AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const Aggreg
 
 void AggregationExecutor::Init() {
   child_->Init();
+  parallel_ = false;
+  partitions_.clear();
+  if (plan_->GetChildPlan()->GetType() == PlanType::Gather) {
+    AggregateParallel(dynamic_cast<GatherExecutor *>(child_.get()));
+    return;
+  }
+  // The groups of the first run live in the query arena. The tables of rescans and of spilled partitions allocate
+  // their entries on their own instead, so that the arena does not grow with every one of them.
+  aht_.Clear(initialized_ ? std::pmr::get_default_resource() : exec_ctx_->GetArena());
+  initialized_ = true;
+  aht_.is_checked_ = false;
+  table_bytes_ = 0;
+  pending_.clear();
+  std::vector<SpillPartition> spill;
+  TupleBatch batch;
+  while (child_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      Aggregate(batch.GetTuple(i), 0, &spill);
+    }
+  }
+  FinishSpill(&spill);
+  aht_iterator_ = aht_.Begin();
+}
+
+void AggregationExecutor::Aggregate(const Tuple &tuple, size_t depth, std::vector<SpillPartition> *spill) {
+  auto key = MakeAggregateKey(&tuple);
+  auto value = MakeAggregateValue(&tuple);
+  if (aht_.CombineExisting(key, value)) {
+    return;
+  }
+  if (!spill->empty()) {
+    (*spill)[SpillPartitionOf(HashKey(key), depth)].file_->Append(tuple);
+    return;
+  }
+  table_bytes_ += GroupBytes(key, value);
+  aht_.InsertCombine(key, value);
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  if (table_bytes_ > exec_ctx_->GetMemoryBudget() && depth < MAX_SPILL_DEPTH && bpm != nullptr) {
+    // The table is full: the tuples of groups that are not in it yet go to the partitions from now on.
+    spill->resize(SPILL_FANOUT);
+    for (auto &partition : *spill) {
+      partition.file_ = std::make_unique<TmpTupleFile>(bpm);
+      partition.depth_ = depth + 1;
+    }
+  }
+}
+
+void AggregationExecutor::FinishSpill(std::vector<SpillPartition> *spill) {
+  size_t num_partitions = 0;
+  size_t num_tuples = 0;
+  // Queue the partitions in reverse so that they are aggregated in hash order.
+  for (auto it = spill->rbegin(); it != spill->rend(); ++it) {
+    it->file_->FinishWrite();
+    if (it->file_->Size() == 0) {
+      continue;
+    }
+    num_partitions++;
+    num_tuples += it->file_->Size();
+    pending_.push_back(std::move(*it));
+  }
+  spill->clear();
+  if (num_partitions > 0) {
+    exec_ctx_->AddStat(plan_, "spilled_partitions", num_partitions);
+    exec_ctx_->AddStat(plan_, "spilled_tuples", num_tuples);
+  }
+}
+
+auto AggregationExecutor::NextSpillPartition() -> bool {
+  if (pending_.empty()) {
+    return false;
+  }
+  auto partition = std::move(pending_.back());
+  pending_.pop_back();
+  aht_.Clear(std::pmr::get_default_resource());
+  table_bytes_ = 0;
+  std::vector<SpillPartition> spill;
   Tuple tuple;
-  RID rid;
-  while (child_->Next(&tuple, &rid)) {
-    auto aggre_key = this->MakeAggregateKey(&tuple);
-    auto aggre_value = this->MakeAggregateValue(&tuple);
-    aht_.InsertCombine(aggre_key, aggre_value);
+  partition.file_->Rewind();
+  while (partition.file_->Next(&tuple)) {
+    Aggregate(tuple, partition.depth_, &spill);
   }
+  partition.file_.reset();
+  FinishSpill(&spill);
   aht_iterator_ = aht_.Begin();
+  return true;
+}
+
+void AggregationExecutor::AggregateParallel(GatherExecutor *gather) {
+  const size_t num_workers = gather->GetNumWorkers();
+  const AggregateValue initial = aht_.GenerateInitialAggregateValue();
+
+  // Pre-aggregate on the workers of the scan, each into its own partitioned tables.
+  std::vector<std::vector<FlatAggregationTable>> locals(num_workers, std::vector<FlatAggregationTable>(NUM_PARTITIONS));
+  gather->RunWorkers([&](size_t worker_idx, TupleBatch *batch) {
+    auto &tables = locals[worker_idx];
+    for (size_t i = 0; i < batch->Size(); i++) {
+      const Tuple *tuple = &batch->GetTuple(i);
+      auto key = MakeAggregateKey(tuple);
+      hash_t hash = HashKey(key);
+      auto &table = tables[hash >> (sizeof(hash_t) * 8 - PARTITION_BITS)];
+      aht_.CombineAggregateValues(table.FindOrInsert(hash, std::move(key), initial), MakeAggregateValue(tuple));
+    }
+  });
+
+  // Merge the tables of each partition, one partition per thread at a time.
+  partitions_.resize(NUM_PARTITIONS);
+  std::atomic<size_t> next_partition{0};
+  std::mutex error_latch;
+  std::exception_ptr error;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_workers; t++) {
+    threads.emplace_back([&] {
+      try {
+        for (size_t p = next_partition++; p < NUM_PARTITIONS; p = next_partition++) {
+          auto &merged = partitions_[p];
+          merged = std::move(locals[0][p]);
+          for (size_t w = 1; w < num_workers; w++) {
+            for (auto &group : locals[w][p].GetGroups()) {
+              aht_.MergeAggregateValues(merged.FindOrInsert(group.hash_, std::move(group.key_), initial),
+                                        group.value_);
+            }
+          }
+        }
+      } catch (...) {
+        std::scoped_lock lock(error_latch);
+        error = std::current_exception();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  parallel_ = true;
+  partition_idx_ = 0;
+  group_idx_ = 0;
+  size_t num_groups = 0;
+  for (const auto &partition : partitions_) {
+    num_groups += partition.Size();
+  }
+  // The empty-input row of an aggregation without groups is emitted only if there are no groups.
+  aht_.is_checked_ = num_groups > 0;
+}
+
+auto AggregationExecutor::NextGroup(const AggregateKey **key, const AggregateValue **value) -> bool {
+  if (!parallel_) {
+    while (aht_iterator_ == aht_.End()) {
+      if (!NextSpillPartition()) {
+        return false;
+      }
+    }
+    *key = &aht_iterator_.Key();
+    *value = &aht_iterator_.Val();
+    ++aht_iterator_;
+    return true;
+  }
+  while (partition_idx_ < partitions_.size()) {
+    auto &groups = partitions_[partition_idx_].GetGroups();
+    if (group_idx_ < groups.size()) {
+      *key = &groups[group_idx_].key_;
+      *value = &groups[group_idx_].value_;
+      group_idx_++;
+      return true;
+    }
+    partition_idx_++;
+    group_idx_ = 0;
+  }
+  return false;
+}
+
+auto AggregationExecutor::MakeOutputTuple(const AggregateKey &key, const AggregateValue &value) const -> Tuple {
+  std::vector<Value> values;
+  values.reserve(key.group_bys_.size() + value.aggregates_.size());
+  values.insert(values.end(), key.group_bys_.begin(), key.group_bys_.end());
+  values.insert(values.end(), value.aggregates_.begin(), value.aggregates_.end());
+  return {values, &plan_->OutputSchema()};
 }
 
 auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (aht_iterator_ == aht_.End()) {
+  const AggregateKey *key;
+  const AggregateValue *value;
+  if (!NextGroup(&key, &value)) {
     if (!plan_->GetGroupBys().empty()) {
       return false;
     }
@@ -49,24 +259,21 @@ auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
     }
     return false;
   }
-  auto aggre_key = aht_iterator_.Key();
-  auto aggre_value = aht_iterator_.Val();
-
-  std::vector<Value> values;
-  values.reserve(aggre_key.group_bys_.size() + aggre_value.aggregates_.size());
-
-  for (auto group_by_key : aggre_key.group_bys_) {
-    values.push_back(group_by_key);
-  }
-  for (auto group_by_value : aggre_value.aggregates_) {
-    values.push_back(group_by_value);
-  }
-  *tuple = Tuple(values, &plan_->OutputSchema());
+  *tuple = MakeOutputTuple(*key, *value);
   *rid = tuple->GetRid();
-  ++aht_iterator_;
   return true;
 }
 
+auto AggregationExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  Tuple tuple;
+  RID rid;
+  while (!batch->IsFull() && Next(&tuple, &rid)) {
+    batch->Append(std::move(tuple), rid);
+  }
+  return !batch->IsEmpty();
+}
+
 auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
 
 }  // namespace bustub
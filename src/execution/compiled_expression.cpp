@@ -0,0 +1,477 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.cpp
+//
+// Identification: src/execution/compiled_expression.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/compiled_expression.h"
+
+#include <cstring>
+#include <functional>
+#include <optional>
+
+#include "common/macros.h"
+#include "execution/data_chunk.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+auto IsInteger(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+/** @return The comparison that gives the same result with its operands swapped */
+auto Mirror(ComparisonType type) -> ComparisonType {
+  switch (type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return type;
+  }
+}
+
+template <typename T>
+inline auto ReadColumn(const char *data, uint32_t offset) -> T {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+template <typename Op, typename T>
+inline void Compare(T lhs, T rhs, bool null, int64_t *out, bool *out_null) {
+  *out = static_cast<int64_t>(Op{}(lhs, rhs));
+  *out_null = null;
+}
+
+}  // namespace
+
+/** Compiler emits the instructions of an expression tree in post order, one fresh register per node. */
+class CompiledExpression::Compiler {
+ public:
+  Compiler(CompiledExpression *program, const Schema *left_schema, const Schema *right_schema)
+      : program_(program), left_schema_(left_schema), right_schema_(right_schema) {}
+
+  auto Emit(const AbstractExpression &expr) -> std::optional<Operand> {
+    if (const auto *column = dynamic_cast<const ColumnValueExpression *>(&expr); column != nullptr) {
+      return EmitColumn(*column);
+    }
+    if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(&expr); constant != nullptr) {
+      return EmitConstant(constant->val_);
+    }
+    if (const auto *comparison = dynamic_cast<const ComparisonExpression *>(&expr); comparison != nullptr) {
+      return EmitComparison(*comparison);
+    }
+    if (const auto *arithmetic = dynamic_cast<const ArithmeticExpression *>(&expr); arithmetic != nullptr) {
+      auto lhs = Emit(*arithmetic->GetChildAt(0));
+      auto rhs = lhs ? Emit(*arithmetic->GetChildAt(1)) : std::nullopt;
+      if (!rhs || lhs->decimal_ || rhs->decimal_) {
+        return std::nullopt;
+      }
+      auto op = arithmetic->compute_type_ == ArithmeticType::Plus ? OpCode::AddInteger : OpCode::SubInteger;
+      return EmitBinary(op, *lhs, *rhs, false);
+    }
+    if (const auto *logic = dynamic_cast<const LogicExpression *>(&expr); logic != nullptr) {
+      auto lhs = Emit(*logic->GetChildAt(0));
+      auto rhs = lhs ? Emit(*logic->GetChildAt(1)) : std::nullopt;
+      if (!rhs) {
+        return std::nullopt;
+      }
+      return EmitBinary(logic->logic_type_ == LogicType::And ? OpCode::And : OpCode::Or, *lhs, *rhs, false);
+    }
+    return std::nullopt;
+  }
+
+ private:
+  auto NewRegister() -> std::optional<uint16_t> {
+    if (registers_ == MAX_REGISTERS) {
+      return std::nullopt;
+    }
+    return registers_++;
+  }
+
+  auto Append(Instruction ins, bool decimal) -> std::optional<Operand> {
+    auto reg = NewRegister();
+    if (!reg) {
+      return std::nullopt;
+    }
+    ins.dst_ = *reg;
+    program_->program_.push_back(ins);
+    return Operand{*reg, decimal};
+  }
+
+  auto EmitBinary(OpCode op, Operand lhs, Operand rhs, bool decimal) -> std::optional<Operand> {
+    Instruction ins{op};
+    ins.lhs_ = lhs.reg_;
+    ins.rhs_ = rhs.reg_;
+    return Append(ins, decimal);
+  }
+
+  /** @return The schema and the column of a column reference, or nullopt if it is not a fixed-length column */
+  auto ResolveColumn(const ColumnValueExpression &expr) -> std::optional<std::pair<uint8_t, const Column *>> {
+    // Outside of joins every column refers to the one input tuple, whatever its tuple index says.
+    uint8_t side = right_schema_ == nullptr ? 0 : static_cast<uint8_t>(expr.GetTupleIdx());
+    const Schema *schema = side == 0 ? left_schema_ : right_schema_;
+    if (side > 1 || expr.GetColIdx() >= schema->GetColumnCount()) {
+      return std::nullopt;
+    }
+    const Column &column = schema->GetColumn(expr.GetColIdx());
+    if (!ColumnVector::IsVectorizable(column.GetType()) || column.GetType() == TypeId::TIMESTAMP) {
+      return std::nullopt;
+    }
+    return std::make_pair(side, &column);
+  }
+
+  auto EmitColumn(const ColumnValueExpression &expr) -> std::optional<Operand> {
+    auto resolved = ResolveColumn(expr);
+    if (!resolved) {
+      return std::nullopt;
+    }
+    const auto &[side, column] = *resolved;
+    Instruction ins{OpCode::LoadInteger};
+    ins.side_ = side;
+    ins.offset_ = column->GetOffset();
+    switch (column->GetType()) {
+      case TypeId::BOOLEAN:
+        ins.op_ = OpCode::LoadBoolean;
+        break;
+      case TypeId::TINYINT:
+        ins.op_ = OpCode::LoadTinyInt;
+        break;
+      case TypeId::SMALLINT:
+        ins.op_ = OpCode::LoadSmallInt;
+        break;
+      case TypeId::INTEGER:
+        break;
+      case TypeId::BIGINT:
+        ins.op_ = OpCode::LoadBigInt;
+        break;
+      case TypeId::DECIMAL:
+        ins.op_ = OpCode::LoadDecimal;
+        break;
+      default:
+        return std::nullopt;
+    }
+    return Append(ins, column->GetType() == TypeId::DECIMAL);
+  }
+
+  auto EmitConstant(const Value &value) -> std::optional<Operand> {
+    const TypeId type = value.GetTypeId();
+    if (!(IsInteger(type) || type == TypeId::BOOLEAN || type == TypeId::DECIMAL)) {
+      return std::nullopt;
+    }
+    Instruction ins{OpCode::LoadNull};
+    if (!value.IsNull()) {
+      if (type == TypeId::DECIMAL) {
+        ins.op_ = OpCode::LoadDecimalImm;
+        ins.imm_.decimal_ = value.GetAs<double>();
+      } else {
+        ins.op_ = OpCode::LoadIntImm;
+        DispatchFixedType(type, [&](auto tag) { ins.imm_.int_ = static_cast<int64_t>(value.GetAs<decltype(tag)>()); });
+      }
+    }
+    return Append(ins, type == TypeId::DECIMAL);
+  }
+
+  /** @return The opcode of the comparison among the six that start at `eq` */
+  static auto ComparisonOp(OpCode eq, ComparisonType type) -> OpCode {
+    return static_cast<OpCode>(static_cast<uint8_t>(eq) + static_cast<uint8_t>(type));
+  }
+
+  auto EmitComparison(const ComparisonExpression &expr) -> std::optional<Operand> {
+    const auto &left = *expr.GetChildAt(0);
+    const auto &right = *expr.GetChildAt(1);
+    const TypeId left_type = left.GetReturnType();
+    const TypeId right_type = right.GetReturnType();
+    const bool numeric = (IsInteger(left_type) || left_type == TypeId::DECIMAL) &&
+                         (IsInteger(right_type) || right_type == TypeId::DECIMAL);
+    if (!numeric && !(left_type == TypeId::BOOLEAN && right_type == TypeId::BOOLEAN)) {
+      return std::nullopt;
+    }
+
+    // INTEGER column against a non-NULL integer constant: one instruction, no registers for the operands.
+    auto fused = [&](const AbstractExpression &col_expr, const AbstractExpression &const_expr,
+                     ComparisonType type) -> std::optional<Operand> {
+      const auto *column = dynamic_cast<const ColumnValueExpression *>(&col_expr);
+      const auto *constant = dynamic_cast<const ConstantValueExpression *>(&const_expr);
+      if (column == nullptr || constant == nullptr || constant->val_.IsNull() ||
+          !IsInteger(constant->val_.GetTypeId())) {
+        return std::nullopt;
+      }
+      auto resolved = ResolveColumn(*column);
+      if (!resolved || resolved->second->GetType() != TypeId::INTEGER) {
+        return std::nullopt;
+      }
+      Instruction ins{ComparisonOp(OpCode::EqIntegerImm, type)};
+      ins.side_ = resolved->first;
+      ins.offset_ = resolved->second->GetOffset();
+      DispatchFixedType(constant->val_.GetTypeId(), [&](auto tag) {
+        ins.imm_.int_ = static_cast<int64_t>(constant->val_.GetAs<decltype(tag)>());
+      });
+      return Append(ins, false);
+    };
+    if (auto op = fused(left, right, expr.comp_type_); op) {
+      return op;
+    }
+    if (auto op = fused(right, left, Mirror(expr.comp_type_)); op) {
+      return op;
+    }
+
+    auto lhs = Emit(left);
+    auto rhs = lhs ? Emit(right) : std::nullopt;
+    if (!rhs) {
+      return std::nullopt;
+    }
+    if (lhs->decimal_ != rhs->decimal_) {
+      // Integers are compared with decimals as decimals.
+      Operand &int_operand = lhs->decimal_ ? *rhs : *lhs;
+      Instruction cast{OpCode::IntToDecimal};
+      cast.lhs_ = int_operand.reg_;
+      auto converted = Append(cast, true);
+      if (!converted) {
+        return std::nullopt;
+      }
+      int_operand = *converted;
+    }
+    return EmitBinary(ComparisonOp(lhs->decimal_ ? OpCode::EqDecimal : OpCode::EqInt, expr.comp_type_), *lhs, *rhs,
+                      false);
+  }
+
+  CompiledExpression *program_;
+  const Schema *left_schema_;
+  const Schema *right_schema_;
+  size_t registers_{0};
+};
+
+static_assert(static_cast<int>(ComparisonType::Equal) == 0 && static_cast<int>(ComparisonType::NotEqual) == 1 &&
+                  static_cast<int>(ComparisonType::LessThan) == 2 &&
+                  static_cast<int>(ComparisonType::LessThanOrEqual) == 3 &&
+                  static_cast<int>(ComparisonType::GreaterThan) == 4 &&
+                  static_cast<int>(ComparisonType::GreaterThanOrEqual) == 5,
+              "the comparison opcodes are laid out in the order of ComparisonType");
+
+auto CompiledExpression::Compile(const AbstractExpression &expr, const Schema &schema)
+    -> std::unique_ptr<CompiledExpression> {
+  auto program = std::make_unique<CompiledExpression>();
+  auto result = Compiler(program.get(), &schema, nullptr).Emit(expr);
+  if (!result) {
+    return nullptr;
+  }
+  program->result_ = result->reg_;
+  program->result_type_ = expr.GetReturnType();
+  return program;
+}
+
+auto CompiledExpression::CompileJoin(const AbstractExpression &expr, const Schema &left_schema,
+                                     const Schema &right_schema) -> std::unique_ptr<CompiledExpression> {
+  auto program = std::make_unique<CompiledExpression>();
+  auto result = Compiler(program.get(), &left_schema, &right_schema).Emit(expr);
+  if (!result) {
+    return nullptr;
+  }
+  program->result_ = result->reg_;
+  program->result_type_ = expr.GetReturnType();
+  return program;
+}
+
+auto CompiledExpression::Run(const Tuple *left_tuple, const Tuple *right_tuple,
+                             std::array<Register, MAX_REGISTERS> *regs) const -> const Register & {
+  const char *data[2] = {left_tuple->GetData(), right_tuple == nullptr ? nullptr : right_tuple->GetData()};
+  Register *r = regs->data();
+  for (const auto &ins : program_) {
+    Register &dst = r[ins.dst_];
+    const Register &lhs = r[ins.lhs_];
+    const Register &rhs = r[ins.rhs_];
+    switch (ins.op_) {
+      case OpCode::LoadTinyInt: {
+        auto value = ReadColumn<int8_t>(data[ins.side_], ins.offset_);
+        dst.int_ = value;
+        dst.null_ = value == BUSTUB_INT8_NULL;
+        break;
+      }
+      case OpCode::LoadSmallInt: {
+        auto value = ReadColumn<int16_t>(data[ins.side_], ins.offset_);
+        dst.int_ = value;
+        dst.null_ = value == BUSTUB_INT16_NULL;
+        break;
+      }
+      case OpCode::LoadInteger: {
+        auto value = ReadColumn<int32_t>(data[ins.side_], ins.offset_);
+        dst.int_ = value;
+        dst.null_ = value == BUSTUB_INT32_NULL;
+        break;
+      }
+      case OpCode::LoadBigInt: {
+        auto value = ReadColumn<int64_t>(data[ins.side_], ins.offset_);
+        dst.int_ = value;
+        dst.null_ = value == BUSTUB_INT64_NULL;
+        break;
+      }
+      case OpCode::LoadDecimal: {
+        auto value = ReadColumn<double>(data[ins.side_], ins.offset_);
+        dst.decimal_ = value;
+        dst.null_ = value == BUSTUB_DECIMAL_NULL;
+        break;
+      }
+      case OpCode::LoadBoolean: {
+        auto value = ReadColumn<int8_t>(data[ins.side_], ins.offset_);
+        dst.int_ = value;
+        dst.null_ = value == BUSTUB_BOOLEAN_NULL;
+        break;
+      }
+      case OpCode::LoadIntImm:
+        dst.int_ = ins.imm_.int_;
+        dst.null_ = false;
+        break;
+      case OpCode::LoadDecimalImm:
+        dst.decimal_ = ins.imm_.decimal_;
+        dst.null_ = false;
+        break;
+      case OpCode::LoadNull:
+        dst.int_ = 0;
+        dst.null_ = true;
+        break;
+      case OpCode::IntToDecimal:
+        dst.decimal_ = static_cast<double>(lhs.int_);
+        dst.null_ = lhs.null_;
+        break;
+      case OpCode::EqInt:
+        Compare<std::equal_to<>>(lhs.int_, rhs.int_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::NeInt:
+        Compare<std::not_equal_to<>>(lhs.int_, rhs.int_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::LtInt:
+        Compare<std::less<>>(lhs.int_, rhs.int_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::LeInt:
+        Compare<std::less_equal<>>(lhs.int_, rhs.int_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::GtInt:
+        Compare<std::greater<>>(lhs.int_, rhs.int_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::GeInt:
+        Compare<std::greater_equal<>>(lhs.int_, rhs.int_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::EqDecimal:
+        Compare<std::equal_to<>>(lhs.decimal_, rhs.decimal_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::NeDecimal:
+        Compare<std::not_equal_to<>>(lhs.decimal_, rhs.decimal_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::LtDecimal:
+        Compare<std::less<>>(lhs.decimal_, rhs.decimal_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::LeDecimal:
+        Compare<std::less_equal<>>(lhs.decimal_, rhs.decimal_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::GtDecimal:
+        Compare<std::greater<>>(lhs.decimal_, rhs.decimal_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::GeDecimal:
+        Compare<std::greater_equal<>>(lhs.decimal_, rhs.decimal_, lhs.null_ || rhs.null_, &dst.int_, &dst.null_);
+        break;
+      case OpCode::EqIntegerImm:
+      case OpCode::NeIntegerImm:
+      case OpCode::LtIntegerImm:
+      case OpCode::LeIntegerImm:
+      case OpCode::GtIntegerImm:
+      case OpCode::GeIntegerImm: {
+        const int64_t value = ReadColumn<int32_t>(data[ins.side_], ins.offset_);
+        const int64_t imm = ins.imm_.int_;
+        bool result;
+        switch (ins.op_) {
+          case OpCode::EqIntegerImm:
+            result = value == imm;
+            break;
+          case OpCode::NeIntegerImm:
+            result = value != imm;
+            break;
+          case OpCode::LtIntegerImm:
+            result = value < imm;
+            break;
+          case OpCode::LeIntegerImm:
+            result = value <= imm;
+            break;
+          case OpCode::GtIntegerImm:
+            result = value > imm;
+            break;
+          default:
+            result = value >= imm;
+            break;
+        }
+        dst.int_ = static_cast<int64_t>(result);
+        dst.null_ = value == BUSTUB_INT32_NULL;
+        break;
+      }
+      case OpCode::AddInteger:
+      case OpCode::SubInteger: {
+        const auto l = static_cast<uint32_t>(lhs.int_);
+        const auto r = static_cast<uint32_t>(rhs.int_);
+        const auto value = static_cast<int32_t>(ins.op_ == OpCode::AddInteger ? l + r : l - r);
+        dst.int_ = value;
+        // A sum that hits the NULL sentinel reads back as NULL, just like a Value built from it.
+        dst.null_ = lhs.null_ || rhs.null_ || value == BUSTUB_INT32_NULL;
+        break;
+      }
+      case OpCode::And:
+      case OpCode::Or: {
+        // A dominating operand (false for AND, true for OR) decides the result even if the other one is NULL.
+        const int64_t dominant = ins.op_ == OpCode::Or ? 1 : 0;
+        if ((!lhs.null_ && lhs.int_ == dominant) || (!rhs.null_ && rhs.int_ == dominant)) {
+          dst.int_ = dominant;
+          dst.null_ = false;
+        } else {
+          dst.int_ = 1 - dominant;
+          dst.null_ = lhs.null_ || rhs.null_;
+        }
+        break;
+      }
+    }
+  }
+  return r[result_];
+}
+
+auto CompiledExpression::EvaluateJoin(const Tuple *left_tuple, const Tuple *right_tuple) const -> Value {
+  std::array<Register, MAX_REGISTERS> regs;
+  const Register &result = Run(left_tuple, right_tuple, &regs);
+  if (result.null_) {
+    return ValueFactory::GetNullValueByType(result_type_);
+  }
+  Value value;
+  DispatchFixedType(result_type_, [&](auto tag) {
+    using T = decltype(tag);
+    if constexpr (std::is_same_v<T, double>) {
+      value = Value(result_type_, result.decimal_);
+    } else {
+      value = Value(result_type_, static_cast<T>(result.int_));
+    }
+  });
+  return value;
+}
+
+auto CompiledExpression::EvaluatePredicate(const Tuple *left_tuple, const Tuple *right_tuple) const -> bool {
+  std::array<Register, MAX_REGISTERS> regs;
+  const Register &result = Run(left_tuple, right_tuple, &regs);
+  return !result.null_ && result.int_ != 0;
+}
+
+}  // namespace bustub
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk.cpp
+//
+// Identification: src/execution/data_chunk.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "execution/data_chunk.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+auto ColumnVector::GetValue(size_t idx) const -> Value {
+  if (IsNull(idx)) {
+    return ValueFactory::GetNullValueByType(type_);
+  }
+  Value value;
+  DispatchFixedType(type_, [&](auto tag) {
+    using T = decltype(tag);
+    value = Value(type_, GetData<T>()[idx]);
+  });
+  return value;
+}
+
+void DataChunk::Reset(const TupleBatch *batch, const Schema *schema) {
+  batch_ = batch;
+  schema_ = schema;
+  sel_.resize(batch->Size());
+  for (uint32_t i = 0; i < sel_.size(); i++) {
+    sel_[i] = i;
+  }
+  columns_.resize(schema->GetColumnCount());
+  loaded_.assign(schema->GetColumnCount(), false);
+}
+
+auto DataChunk::GetColumn(uint32_t col_idx) const -> const ColumnVector * {
+  if (loaded_[col_idx]) {
+    return &columns_[col_idx];
+  }
+  const auto &column = schema_->GetColumn(col_idx);
+  auto &vector = columns_[col_idx];
+  // Fixed-length columns sit at a fixed offset of every tuple, so they are copied straight out of the tuple data.
+  bool vectorizable = DispatchFixedType(column.GetType(), [&](auto tag) {
+    using T = decltype(tag);
+    vector.Initialize(column.GetType(), batch_->Size());
+    T *data = vector.GetData<T>();
+    const T null = NullSentinel<T>(column.GetType());
+    const uint32_t offset = column.GetOffset();
+    for (auto idx : sel_) {
+      memcpy(&data[idx], batch_->GetTuple(idx).GetData() + offset, sizeof(T));
+      if (data[idx] == null) {
+        vector.SetNull(idx);
+      }
+    }
+  });
+  if (!vectorizable) {
+    return nullptr;
+  }
+  loaded_[col_idx] = true;
+  return &vector;
+}
+
+void DataChunk::Select(const ColumnVector &predicate) {
+  const auto *values = predicate.GetData<int8_t>();
+  size_t kept = 0;
+  for (auto idx : sel_) {
+    if (values[idx] != 0 && !predicate.IsNull(idx)) {
+      sel_[kept++] = idx;
+    }
+  }
+  sel_.resize(kept);
+}
+
+}  // namespace bustub
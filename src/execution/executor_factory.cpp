@@ -19,10 +19,12 @@
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/delete_executor.h"
 #include "execution/executors/filter_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/executors/hash_join_executor.h"
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/limit_executor.h"
+#include "execution/executors/merge_join_executor.h"
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
@@ -33,6 +35,7 @@
 #include "execution/executors/update_executor.h"
 #include "execution/executors/values_executor.h"
 #include "execution/plans/filter_plan.h"
+#include "execution/plans/gather_plan.h"
 #include "execution/plans/mock_scan_plan.h"
 #include "execution/plans/projection_plan.h"
 #include "execution/plans/sort_plan.h"
@@ -114,6 +117,14 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left), std::move(right));
     }
 
+    // Create a new merge join executor
+    case PlanType::MergeJoin: {
+      const auto *merge_join_plan = dynamic_cast<const MergeJoinPlanNode *>(plan.get());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetLeftPlan());
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetRightPlan());
+      return std::make_unique<MergeJoinExecutor>(exec_ctx, merge_join_plan, std::move(left), std::move(right));
+    }
+
     // Create a new mock scan executor
     case PlanType::MockScan: {
       const auto *mock_scan_plan = dynamic_cast<const MockScanPlanNode *>(plan.get());
@@ -154,6 +165,10 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
       return std::make_unique<TopNExecutor>(exec_ctx, topn_plan, std::move(child));
     }
 
+    case PlanType::Gather: {
+      return std::make_unique<GatherExecutor>(exec_ctx, dynamic_cast<const GatherPlanNode *>(plan.get()));
+    }
+
     default:
       UNREACHABLE("Unsupported plan type.");
   }
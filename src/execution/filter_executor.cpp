@@ -6,7 +6,9 @@ namespace bustub {
 
 FilterExecutor::FilterExecutor(ExecutorContext *exec_ctx, const FilterPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+  program_ = CompiledExpression::Compile(*plan_->GetPredicate(), child_executor_->GetOutputSchema());
+}
 
 void FilterExecutor::Init() {
   // Initialize the child executor
@@ -24,6 +26,12 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
       return false;
     }
 
+    if (program_ != nullptr) {
+      if (program_->EvaluatePredicate(tuple)) {
+        return true;
+      }
+      continue;
+    }
     auto value = filter_expr->Evaluate(tuple, child_executor_->GetOutputSchema());
     if (!value.IsNull() && value.GetAs<bool>()) {
       return true;
@@ -31,4 +39,35 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 }
 
+auto FilterExecutor::NextBatch(TupleBatch *batch) -> bool {
+  const auto &filter_expr = plan_->GetPredicate();
+  const auto &child_schema = child_executor_->GetOutputSchema();
+
+  // Filter the child's batch in place; pull again if nothing of it qualifies.
+  while (child_executor_->NextBatch(batch)) {
+    if (program_ != nullptr) {
+      batch->Retain([&](const Tuple &tuple) { return program_->EvaluatePredicate(&tuple); });
+      if (!batch->IsEmpty()) {
+        return true;
+      }
+      continue;
+    }
+    chunk_.Reset(batch, &child_schema);
+    if (filter_expr->EvaluateVector(chunk_, &predicate_)) {
+      chunk_.Select(predicate_);
+      batch->Select(chunk_.GetSelection());
+    } else {
+      // Some part of the predicate has no vector kernel, e.g. it compares strings.
+      batch->Retain([&](const Tuple &tuple) {
+        auto value = filter_expr->Evaluate(&tuple, child_schema);
+        return !value.IsNull() && value.GetAs<bool>();
+      });
+    }
+    if (!batch->IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace bustub
@@ -0,0 +1,178 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.cpp
+//
+// Identification: src/execution/gather_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/gather_executor.h"
+
+#include <utility>
+
+#include "execution/executor_factory.h"
+#include "execution/plans/seq_scan_plan.h"
+
+namespace bustub {
+
+GatherExecutor::GatherExecutor(ExecutorContext *exec_ctx, const GatherPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+GatherExecutor::~GatherExecutor() { StopWorkers(); }
+
+void GatherExecutor::Init() {
+  StopWorkers();
+  queue_.clear();
+  running_ = 0;
+  started_ = false;
+  stopped_ = false;
+  error_ = nullptr;
+  current_.Reset();
+  current_idx_ = 0;
+
+  if (workers_.empty()) {
+    // The child is a chain of single-child operators that ends in the scan whose pages the workers split.
+    const AbstractPlanNode *scan = plan_->GetChildPlan().get();
+    while (scan->GetType() != PlanType::SeqScan) {
+      BUSTUB_ASSERT(scan->GetChildren().size() == 1, "gather expects a pipeline over a sequential scan");
+      scan = scan->GetChildAt(0).get();
+    }
+    const auto *scan_plan = dynamic_cast<const SeqScanPlanNode *>(scan);
+    auto *table_heap = exec_ctx_->GetCatalog()->GetTable(scan_plan->GetTableOid())->table_.get();
+    dispenser_ = std::make_unique<MorselDispenser>(table_heap);
+    exec_ctx_->SetMorselDispenser(scan, dispenser_.get());
+    for (size_t i = 0; i < plan_->GetNumWorkers(); i++) {
+      workers_.emplace_back(ExecutorFactory::CreateExecutor(exec_ctx_, plan_->GetChildPlan()));
+    }
+  } else {
+    dispenser_->Reset();
+  }
+
+  // Workers are initialized here rather than on their threads, so that only this thread touches the context.
+  for (auto &worker : workers_) {
+    worker->Init();
+  }
+}
+
+void GatherExecutor::StartWorkers() {
+  started_ = true;
+  running_ = workers_.size();
+  for (auto &worker : workers_) {
+    threads_.emplace_back(&GatherExecutor::RunWorker, this, worker.get());
+  }
+}
+
+void GatherExecutor::RunWorkers(const std::function<void(size_t, TupleBatch *)> &sink) {
+  BUSTUB_ASSERT(!started_, "the workers already run");
+  started_ = true;
+  for (size_t i = 0; i < workers_.size(); i++) {
+    threads_.emplace_back([this, &sink, i] {
+      TupleBatch batch;
+      try {
+        while (!stopped_ && workers_[i]->NextBatch(&batch)) {
+          sink(i, &batch);
+        }
+      } catch (...) {
+        std::scoped_lock lock(latch_);
+        if (error_ == nullptr) {
+          error_ = std::current_exception();
+        }
+        stopped_ = true;
+      }
+    });
+  }
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void GatherExecutor::RunWorker(AbstractExecutor *worker) {
+  const size_t capacity = QUEUED_BATCHES_PER_WORKER * workers_.size();
+  TupleBatch batch;
+  try {
+    while (worker->NextBatch(&batch)) {
+      std::unique_lock lock(latch_);
+      not_full_.wait(lock, [&] { return stopped_ || queue_.size() < capacity; });
+      if (stopped_) {
+        break;
+      }
+      queue_.push_back(std::move(batch));
+      if (free_batches_.empty()) {
+        batch = TupleBatch();
+      } else {
+        batch = std::move(free_batches_.back());
+        free_batches_.pop_back();
+      }
+      not_empty_.notify_one();
+    }
+  } catch (...) {
+    std::scoped_lock lock(latch_);
+    if (error_ == nullptr) {
+      error_ = std::current_exception();
+    }
+    stopped_ = true;
+    not_full_.notify_all();
+  }
+  std::scoped_lock lock(latch_);
+  running_--;
+  not_empty_.notify_all();
+}
+
+auto GatherExecutor::PopBatch(TupleBatch *batch) -> bool {
+  if (!started_) {
+    StartWorkers();
+  }
+  std::unique_lock lock(latch_);
+  not_empty_.wait(lock, [&] { return error_ != nullptr || !queue_.empty() || running_ == 0; });
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+  if (queue_.empty()) {
+    return false;
+  }
+  std::swap(*batch, queue_.front());
+  free_batches_.push_back(std::move(queue_.front()));
+  queue_.pop_front();
+  not_full_.notify_one();
+  return true;
+}
+
+auto GatherExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (current_idx_ == current_.Size()) {
+    current_idx_ = 0;
+    if (!PopBatch(&current_)) {
+      current_.Reset();
+      return false;
+    }
+  }
+  *rid = current_.GetRid(current_idx_);
+  *tuple = std::move(current_.GetTuple(current_idx_++));
+  return true;
+}
+
+auto GatherExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  return PopBatch(batch);
+}
+
+void GatherExecutor::StopWorkers() {
+  {
+    std::scoped_lock lock(latch_);
+    stopped_ = true;
+    not_full_.notify_all();
+  }
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+}  // namespace bustub
@@ -11,24 +11,340 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/hash_join_executor.h"
-
-// Note for 2022 Fall: You don't need to implement HashJoinExecutor to pass all tests. You ONLY need to implement it
-// if you want to get faster in leaderboard tests.
+#include "type/value_factory.h"
 
 namespace bustub {
 
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_child_(std::move(left_child)),
+      right_child_(std::move(right_child)) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
+  if (plan->runtime_filter_.has_value()) {
+    runtime_filter_ = std::make_unique<RuntimeFilter>();
+    exec_ctx->SetRuntimeFilter(*plan->runtime_filter_, runtime_filter_.get());
+  }
+}
+
+auto HashJoinExecutor::HashKey(const AbstractExpression &key_expr, Tuple tuple, const Schema &schema)
+    -> HashedTuple {
+  auto key = key_expr.Evaluate(&tuple, schema);
+  hash_t hash = key.IsNull() ? 0 : HashUtil::MixHash(HashUtil::HashValue(&key));
+  return {std::move(tuple), std::move(key), hash};
+}
+
+void HashJoinExecutor::Init() {
+  // The probe side is initialized only once the build side is read: a scan there picks up the runtime filter in Init.
+  right_child_->Init();
+  if (runtime_filter_ != nullptr) {
+    runtime_filter_->Reset();
+  }
+  spilled_ = false;
+  pending_.clear();
+  probe_file_.reset();
+  probe_batch_.Reset();
+  probe_batch_idx_ = 0;
+  partitions_.clear();
+  radix_bits_ = 0;
+  probe_exhausted_ = true;
+  has_probe_ = false;
+
+  // Materialize the build side. A NULL key never matches, so those tuples can be dropped right away.
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  const size_t budget = exec_ctx_->GetMemoryBudget();
+  std::vector<HashedTuple> build;
+  std::vector<SpillPartition> spill;
+  std::vector<int64_t> filter_keys;
+  size_t build_bytes = 0;
+  // The build tuples of the first run are copied into the query arena, which leaves the buffers of the batch to be
+  // reused. Rescans and spilled joins allocate them on their own, so that the arena does not grow with every run.
+  Arena *arena = initialized_ ? nullptr : exec_ctx_->GetArena();
+  initialized_ = true;
+  TupleBatch batch;
+  const auto &right_schema = right_child_->GetOutputSchema();
+  while (right_child_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      Tuple &tuple = batch.GetTuple(i);
+      auto entry = HashKey(plan_->RightJoinKeyExpression(), arena != nullptr ? Tuple(tuple, arena) : std::move(tuple),
+                           right_schema);
+      if (entry.key_.IsNull()) {
+        continue;
+      }
+      if (runtime_filter_ != nullptr) {
+        filter_keys.push_back(entry.key_.CastAs(TypeId::BIGINT).GetAs<int64_t>());
+      }
+      if (spilled_) {
+        spill[SpillPartitionOf(entry.hash_, 0)].build_->Append(entry.tuple_);
+        continue;
+      }
+      build_bytes += EntryBytes(entry.tuple_);
+      build.push_back(std::move(entry));
+      if (build_bytes > budget && bpm != nullptr) {
+        // Over budget: from now on every build tuple goes to a spill partition, starting with the ones read so far.
+        spilled_ = true;
+        arena = nullptr;
+        spill = MakeSpillPartitions(0);
+        for (const auto &spilled : build) {
+          spill[SpillPartitionOf(spilled.hash_, 0)].build_->Append(spilled.tuple_);
+        }
+        build.clear();
+        build.shrink_to_fit();
+      }
+    }
+  }
+
+  if (runtime_filter_ != nullptr) {
+    runtime_filter_->Build(filter_keys);
+  }
+  left_child_->Init();
+
+  if (!spilled_) {
+    JoinInMemory(std::move(build));
+    return;
+  }
+
+  // Split the probe side the same way. Probe tuples with a NULL key only matter to a LEFT join; their hash is 0, so
+  // they all end up in the first partition.
+  const auto &left_schema = left_child_->GetOutputSchema();
+  while (left_child_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      auto entry = HashKey(plan_->LeftJoinKeyExpression(), std::move(batch.GetTuple(i)), left_schema);
+      if (!entry.key_.IsNull() || plan_->GetJoinType() == JoinType::LEFT) {
+        spill[SpillPartitionOf(entry.hash_, 0)].probe_->Append(entry.tuple_);
+      }
+    }
+  }
+  QueueSpillPartitions(&spill);
+  NextSpillPartition();
+}
+
+auto HashJoinExecutor::MakeSpillPartitions(size_t depth) -> std::vector<SpillPartition> {
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  std::vector<SpillPartition> partitions(SPILL_FANOUT);
+  for (auto &partition : partitions) {
+    partition.build_ = std::make_unique<TmpTupleFile>(bpm);
+    partition.probe_ = std::make_unique<TmpTupleFile>(bpm);
+    partition.depth_ = depth;
+  }
+  return partitions;
+}
+
+void HashJoinExecutor::SplitSpillPartition(SpillPartition *partition) {
+  const size_t depth = partition->depth_ + 1;
+  auto children = MakeSpillPartitions(depth);
+  Tuple tuple;
+  partition->build_->Rewind();
+  while (partition->build_->Next(&tuple)) {
+    auto entry = HashKey(plan_->RightJoinKeyExpression(), std::move(tuple), right_child_->GetOutputSchema());
+    children[SpillPartitionOf(entry.hash_, depth)].build_->Append(entry.tuple_);
+  }
+  partition->probe_->Rewind();
+  while (partition->probe_->Next(&tuple)) {
+    auto entry = HashKey(plan_->LeftJoinKeyExpression(), std::move(tuple), left_child_->GetOutputSchema());
+    children[SpillPartitionOf(entry.hash_, depth)].probe_->Append(entry.tuple_);
+  }
+  partition->build_.reset();
+  partition->probe_.reset();
+  QueueSpillPartitions(&children);
+}
+
+void HashJoinExecutor::QueueSpillPartitions(std::vector<SpillPartition> *partitions) {
+  size_t build_tuples = 0;
+  size_t probe_tuples = 0;
+  for (auto it = partitions->rbegin(); it != partitions->rend(); ++it) {
+    it->build_->FinishWrite();
+    it->probe_->FinishWrite();
+    build_tuples += it->build_->Size();
+    probe_tuples += it->probe_->Size();
+    pending_.push_back(std::move(*it));
+  }
+  exec_ctx_->AddStat(plan_, "spilled_partitions", partitions->size());
+  exec_ctx_->AddStat(plan_, "spilled_build_tuples", build_tuples);
+  exec_ctx_->AddStat(plan_, "spilled_probe_tuples", probe_tuples);
+}
+
+auto HashJoinExecutor::NextSpillPartition() -> bool {
+  while (!pending_.empty()) {
+    auto partition = std::move(pending_.back());
+    pending_.pop_back();
+    if (partition.build_->Size() == 0 && plan_->GetJoinType() == JoinType::INNER) {
+      continue;
+    }
+    size_t build_bytes = partition.build_->Bytes() + partition.build_->Size() * sizeof(HashedTuple);
+    if (build_bytes > exec_ctx_->GetMemoryBudget() && partition.depth_ + 1 < MAX_SPILL_DEPTH) {
+      SplitSpillPartition(&partition);
+      continue;
+    }
+
+    std::vector<HashedTuple> build;
+    build.reserve(partition.build_->Size());
+    Tuple tuple;
+    partition.build_->Rewind();
+    while (partition.build_->Next(&tuple)) {
+      build.push_back(HashKey(plan_->RightJoinKeyExpression(), std::move(tuple), right_child_->GetOutputSchema()));
+    }
+    partition.build_.reset();
+    probe_file_ = std::move(partition.probe_);
+    probe_file_->Rewind();
+    JoinInMemory(std::move(build));
+    return true;
+  }
+  probe_file_.reset();
+  return false;
+}
+
+void HashJoinExecutor::JoinInMemory(std::vector<HashedTuple> build) {
+  partitions_.clear();
+  partition_idx_ = 0;
+  probe_exhausted_ = false;
+  has_probe_ = false;
+
+  radix_bits_ = 0;
+  while (radix_bits_ < MAX_RADIX_BITS && (build.size() >> radix_bits_) > PARTITION_TUPLES) {
+    radix_bits_++;
+  }
+
+  if (radix_bits_ == 0) {
+    // One partition; an inner join with nothing to match is empty.
+    partitions_.resize(1);
+    partitions_[0].build_ = std::move(build);
+    probe_exhausted_ = plan_->GetJoinType() == JoinType::INNER && partitions_[0].build_.empty();
+  } else {
+    partitions_.resize(static_cast<size_t>(1) << radix_bits_);
+    const hash_t partition_mask = partitions_.size() - 1;
+    for (auto &entry : build) {
+      partitions_[entry.hash_ & partition_mask].build_.push_back(std::move(entry));
+    }
+    build.clear();
+    build.shrink_to_fit();
+  }
+  // Every partition keeps its table for the whole join, since the probe tuples arrive in no particular order.
+  for (auto &partition : partitions_) {
+    BuildTable(&partition);
+  }
+}
+
+auto HashJoinExecutor::NextProbeTuple(Tuple *tuple) -> bool {
+  if (spilled_) {
+    return probe_file_->Next(tuple);
+  }
+  if (probe_batch_idx_ == probe_batch_.Size()) {
+    if (!left_child_->NextBatch(&probe_batch_)) {
+      return false;
+    }
+    probe_batch_idx_ = 0;
+  }
+  *tuple = std::move(probe_batch_.GetTuple(probe_batch_idx_++));
+  return true;
+}
+
+void HashJoinExecutor::BuildTable(Partition *partition) const {
+  const auto &build = partition->build_;
+  BUSTUB_ASSERT(build.size() < UINT32_MAX, "partition too large");
+  size_t num_buckets = 1;
+  while (num_buckets < build.size() * 2) {
+    num_buckets <<= 1;
+  }
+  partition->heads_.assign(num_buckets, 0);
+  partition->next_.assign(build.size(), 0);
+  partition->bucket_mask_ = num_buckets - 1;
+  // Push to the chain fronts back to front so that each chain lists its tuples in build order. The bits above the
+  // partition bits pick the bucket, since all tuples of a partition agree on the low ones.
+  for (auto i = static_cast<uint32_t>(build.size()); i > 0; i--) {
+    auto &head = partition->heads_[(build[i - 1].hash_ >> radix_bits_) & partition->bucket_mask_];
+    partition->next_[i - 1] = head;
+    head = i;
+  }
 }
 
-void HashJoinExecutor::Init() { throw NotImplementedException("HashJoinExecutor is not implemented"); }
+auto HashJoinExecutor::AdvanceInMemoryProbe() -> bool {
+  Tuple tuple;
+  if (probe_exhausted_ || !NextProbeTuple(&tuple)) {
+    probe_exhausted_ = true;
+    return false;
+  }
+  probe_ = HashKey(plan_->LeftJoinKeyExpression(), std::move(tuple), left_child_->GetOutputSchema());
+  partition_idx_ = probe_.hash_ & (partitions_.size() - 1);
 
-auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+  const auto &left_schema = left_child_->GetOutputSchema();
+  probe_values_.clear();
+  for (uint32_t i = 0; i < left_schema.GetColumnCount(); i++) {
+    probe_values_.push_back(probe_.tuple_.GetValue(&left_schema, i));
+  }
+  has_probe_ = true;
+  matched_ = false;
+  const auto &partition = partitions_[partition_idx_];
+  chain_ = probe_.key_.IsNull() ? 0 : partition.heads_[(probe_.hash_ >> radix_bits_) & partition.bucket_mask_];
+  return true;
+}
+
+auto HashJoinExecutor::AdvanceProbe() -> bool {
+  while (!AdvanceInMemoryProbe()) {
+    if (!spilled_ || !NextSpillPartition()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto HashJoinExecutor::MakeOutput(const Tuple *build) const -> Tuple {
+  const auto &right_schema = right_child_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(probe_values_.size() + right_schema.GetColumnCount());
+  values.insert(values.end(), probe_values_.begin(), probe_values_.end());
+  for (uint32_t i = 0; i < right_schema.GetColumnCount(); i++) {
+    values.push_back(build != nullptr ? build->GetValue(&right_schema, i)
+                                      : ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+  }
+  return Tuple(values, &plan_->OutputSchema());
+}
+
+auto HashJoinExecutor::Produce(Tuple *tuple) -> bool {
+  while (true) {
+    if (has_probe_) {
+      const auto &partition = partitions_[partition_idx_];
+      while (chain_ != 0) {
+        const auto &entry = partition.build_[chain_ - 1];
+        chain_ = partition.next_[chain_ - 1];
+        if (entry.hash_ == probe_.hash_ && entry.key_.CompareEquals(probe_.key_) == CmpBool::CmpTrue) {
+          matched_ = true;
+          *tuple = MakeOutput(&entry.tuple_);
+          return true;
+        }
+      }
+      has_probe_ = false;
+      if (!matched_ && plan_->GetJoinType() == JoinType::LEFT) {
+        *tuple = MakeOutput(nullptr);
+        return true;
+      }
+    }
+    if (!AdvanceProbe()) {
+      return false;
+    }
+  }
+}
+
+auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!Produce(tuple)) {
+    return false;
+  }
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto HashJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  Tuple tuple;
+  while (!batch->IsFull() && Produce(&tuple)) {
+    batch->Append(std::move(tuple), RID{});
+  }
+  return !batch->IsEmpty();
+}
 
 }  // namespace bustub
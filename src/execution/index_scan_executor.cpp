@@ -13,25 +13,51 @@
 
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx), plan_(plan), begin_(0, exec_ctx->GetBufferPoolManager(), 0) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), begin_(INVALID_PAGE_ID, exec_ctx->GetBufferPoolManager(), 0) {}
 
 void IndexScanExecutor::Init() {
   auto index = exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid());
-  tree_ = dynamic_cast<BPlusTreeIndexForOneIntegerColumn *>(index->index_.get());
   auto table_info = exec_ctx_->GetCatalog()->GetTable(index->table_name_);
   table_ = table_info->table_.get();
+  emitted_ = 0;
+
+  if (plan_->GetLookupKey() != nullptr) {
+    // Point lookup works on every index type.
+    rids_.clear();
+    cursor_ = 0;
+    std::vector<Value> key_values{plan_->GetLookupKey()->Evaluate(nullptr, index->key_schema_)};
+    Tuple key(key_values, &index->key_schema_);
+    index->index_->ScanKey(key, &rids_, exec_ctx_->GetTransaction());
+    return;
+  }
+
+  tree_ = dynamic_cast<BPlusTreeIndexForOneIntegerColumn *>(index->index_.get());
+  BUSTUB_ENSURE(tree_ != nullptr, "ordered index scan requires a B+ tree index");
   begin_ = tree_->GetBeginIterator();
-  
-  
 }
 
 auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (plan_->limit_.has_value() && emitted_ >= *plan_->limit_) {
+    return false;
+  }
+  if (plan_->GetLookupKey() != nullptr) {
+    while (cursor_ < rids_.size()) {
+      *rid = rids_[cursor_++];
+      if (table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction())) {
+        emitted_++;
+        return true;
+      }
+    }
+    return false;
+  }
+
   if (begin_.IsEnd()) {
     return false;
   }
   *rid = (*begin_).second;
   table_->GetTuple(*rid, tuple, exec_ctx_->GetTransaction());
   ++begin_;
+  emitted_++;
   return true;
 }
 
@@ -18,7 +18,10 @@ LimitExecutor::LimitExecutor(ExecutorContext *exec_ctx, const LimitPlanNode *pla
                              std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
 
-void LimitExecutor::Init() { child_executor_->Init(); }
+void LimitExecutor::Init() {
+  child_executor_->Init();
+  idx_ = 0;
+}
 
 auto LimitExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   if (idx_ >= plan_->GetLimit()) {
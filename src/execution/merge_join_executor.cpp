@@ -0,0 +1,160 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_child_(std::move(left_child)),
+      right_child_(std::move(right_child)) {
+  if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
+    throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
+  }
+}
+
+void MergeJoinExecutor::Init() {
+  left_child_->Init();
+  right_child_->Init();
+  const auto &right_schema = right_child_->GetOutputSchema();
+  BUSTUB_ASSERT(plan_->OutputSchema().GetLength() == left_child_->GetOutputSchema().GetLength() +
+                                                         right_schema.GetLength(),
+                "the output must be the columns of the left side followed by those of the right side");
+  if (plan_->GetJoinType() == JoinType::LEFT) {
+    std::vector<Value> nulls;
+    for (const auto &column : right_schema.GetColumns()) {
+      nulls.push_back(ValueFactory::GetNullValueByType(column.GetType()));
+    }
+    null_right_ = Tuple(nulls, &right_schema);
+  }
+
+  left_batch_.Reset();
+  left_idx_ = 0;
+  left_exhausted_ = false;
+  has_left_ = false;
+  right_batch_.Reset();
+  right_keys_.clear();
+  right_idx_ = 0;
+  right_exhausted_ = false;
+  group_.clear();
+  group_idx_ = 0;
+  done_ = false;
+}
+
+auto MergeJoinExecutor::AdvanceLeft() -> bool {
+  if (left_idx_ + 1 < left_batch_.Size()) {
+    left_idx_++;
+  } else {
+    if (left_exhausted_ || !left_child_->NextBatch(&left_batch_)) {
+      left_exhausted_ = true;
+      return false;
+    }
+    left_idx_ = 0;
+  }
+  left_key_ = plan_->LeftJoinKeyExpression().Evaluate(&left_batch_.GetTuple(left_idx_), left_child_->GetOutputSchema());
+  return true;
+}
+
+auto MergeJoinExecutor::FillRight() -> bool {
+  if (right_idx_ < right_batch_.Size()) {
+    return true;
+  }
+  if (right_exhausted_ || !right_child_->NextBatch(&right_batch_)) {
+    right_exhausted_ = true;
+    return false;
+  }
+  right_idx_ = 0;
+  right_keys_.clear();
+  const auto &schema = right_child_->GetOutputSchema();
+  for (size_t i = 0; i < right_batch_.Size(); i++) {
+    right_keys_.push_back(plan_->RightJoinKeyExpression().Evaluate(&right_batch_.GetTuple(i), schema));
+  }
+  return true;
+}
+
+void MergeJoinExecutor::LoadGroup(const Value &key) {
+  group_.clear();
+  while (FillRight()) {
+    const Value &right_key = right_keys_[right_idx_];
+    if (right_key.IsNull() || right_key.CompareLessThan(key) == CmpBool::CmpTrue) {
+      right_idx_++;
+      continue;
+    }
+    if (right_key.CompareEquals(key) != CmpBool::CmpTrue) {
+      break;
+    }
+    group_.push_back(std::move(right_batch_.GetTuple(right_idx_++)));
+  }
+  group_key_ = key;
+}
+
+auto MergeJoinExecutor::Produce(Tuple *tuple) -> bool {
+  const auto &left_schema = left_child_->GetOutputSchema();
+  const auto &right_schema = right_child_->GetOutputSchema();
+  while (!done_) {
+    if (!has_left_) {
+      if (!AdvanceLeft()) {
+        done_ = true;
+        return false;
+      }
+      has_left_ = true;
+      group_idx_ = 0;
+      left_matches_ = false;
+      if (!left_key_.IsNull()) {
+        if (group_.empty() || group_key_.CompareEquals(left_key_) != CmpBool::CmpTrue) {
+          LoadGroup(left_key_);
+        }
+        left_matches_ = !group_.empty();
+        // Every later left key is at least this one, which is past the last right key.
+        if (!left_matches_ && right_exhausted_ && plan_->GetJoinType() == JoinType::INNER) {
+          done_ = true;
+          return false;
+        }
+      }
+    }
+    const Tuple &left_tuple = left_batch_.GetTuple(left_idx_);
+    if (left_matches_ && group_idx_ < group_.size()) {
+      *tuple = Tuple::Concat(left_tuple, left_schema, group_[group_idx_++], right_schema);
+      return true;
+    }
+    has_left_ = false;
+    if (!left_matches_ && plan_->GetJoinType() == JoinType::LEFT) {
+      *tuple = Tuple::Concat(left_tuple, left_schema, null_right_, right_schema);
+      return true;
+    }
+  }
+  return false;
+}
+
+auto MergeJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!Produce(tuple)) {
+    return false;
+  }
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto MergeJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  Tuple tuple;
+  while (!batch->IsFull() && Produce(&tuple)) {
+    batch->Append(std::move(tuple), RID{});
+  }
+  return !batch->IsEmpty();
+}
+
+}  // namespace bustub
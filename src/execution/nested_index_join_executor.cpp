@@ -10,21 +10,152 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <numeric>
+
 #include "execution/executors/nested_index_join_executor.h"
 
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      block_(exec_ctx->GetJoinBlockSize()) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2022 Fall: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  index_info_ = exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid());
+  table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableOid());
+  const auto &inner_schema = plan_->InnerTableSchema();
+  if (plan_->GetJoinType() == JoinType::LEFT) {
+    std::vector<Value> nulls;
+    for (const auto &column : inner_schema.GetColumns()) {
+      nulls.push_back(ValueFactory::GetNullValueByType(column.GetType()));
+    }
+    null_inner_ = Tuple(nulls, &inner_schema);
+  }
+  block_.Reset();
+  matches_.clear();
+  child_exhausted_ = false;
+  outer_idx_ = 0;
+  match_idx_ = 0;
+  matched_ = false;
+}
+
+auto NestIndexJoinExecutor::LoadBlock() -> bool {
+  outer_idx_ = 0;
+  if (child_exhausted_ || !child_executor_->NextBatch(&block_)) {
+    child_exhausted_ = true;
+    block_.Reset();
+    return false;
+  }
+  match_idx_ = 0;
+  matched_ = false;
+  matches_.clear();
+
+  // Evaluate the join keys. A NULL key never matches.
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  const auto &key_schema = index_info_->key_schema_;
+  const TypeId key_type = key_schema.GetColumn(0).GetType();
+  std::vector<Value> keys;
+  std::vector<uint32_t> order;
+  keys.reserve(block_.Size());
+  for (size_t i = 0; i < block_.Size(); i++) {
+    auto key = plan_->KeyPredicate()->Evaluate(&block_.GetTuple(i), outer_schema);
+    if (!key.IsNull()) {
+      order.push_back(i);
+    }
+    keys.push_back(key.GetTypeId() == key_type || key.IsNull() ? std::move(key) : key.CastAs(key_type));
+  }
+
+  // Probe the index once per distinct key, in key order.
+  std::stable_sort(order.begin(), order.end(),
+                   [&](uint32_t a, uint32_t b) { return keys[a].CompareLessThan(keys[b]) == CmpBool::CmpTrue; });
+  std::vector<Tuple> probe_keys;
+  std::vector<size_t> first_outer;
+  for (size_t i = 0; i < order.size(); i++) {
+    if (i == 0 || keys[order[i - 1]].CompareEquals(keys[order[i]]) != CmpBool::CmpTrue) {
+      probe_keys.emplace_back(std::vector<Value>{keys[order[i]]}, &key_schema);
+      first_outer.push_back(i);
+    }
+  }
+  first_outer.push_back(order.size());
+  std::vector<std::pair<size_t, RID>> results;
+  index_info_->index_->ScanKeys(probe_keys, &results, exec_ctx_->GetTransaction());
+
+  // Fetch the inner tuples in rid order, which visits each page once.
+  for (const auto &[key_idx, rid] : results) {
+    for (size_t i = first_outer[key_idx]; i < first_outer[key_idx + 1]; i++) {
+      matches_.push_back({order[i], rid, Tuple{}, false});
+    }
+  }
+  std::sort(matches_.begin(), matches_.end(),
+            [](const Match &a, const Match &b) { return a.rid_.Get() < b.rid_.Get(); });
+  std::vector<RID> rids;
+  rids.reserve(matches_.size());
+  for (const auto &match : matches_) {
+    rids.push_back(match.rid_);
+  }
+  std::vector<Tuple> inner_tuples;
+  std::vector<bool> found;
+  table_info_->table_->GetTuples(rids, exec_ctx_->GetTransaction(), &inner_tuples, &found);
+  for (size_t i = 0; i < matches_.size(); i++) {
+    matches_[i].inner_ = std::move(inner_tuples[i]);
+    matches_[i].found_ = found[i];
+  }
+  std::stable_sort(matches_.begin(), matches_.end(),
+                   [](const Match &a, const Match &b) { return a.outer_idx_ < b.outer_idx_; });
+  return true;
+}
+
+auto NestIndexJoinExecutor::Produce(Tuple *tuple) -> bool {
+  const auto &outer_schema = child_executor_->GetOutputSchema();
+  const auto &inner_schema = plan_->InnerTableSchema();
+  while (true) {
+    if (outer_idx_ == block_.Size() && !LoadBlock()) {
+      return false;
+    }
+    const Tuple &outer = block_.GetTuple(outer_idx_);
+    while (match_idx_ < matches_.size() && matches_[match_idx_].outer_idx_ == outer_idx_) {
+      const auto &match = matches_[match_idx_++];
+      if (match.found_) {
+        matched_ = true;
+        *tuple = Tuple::Concat(outer, outer_schema, match.inner_, inner_schema);
+        return true;
+      }
+    }
+    const bool pad = !matched_ && plan_->GetJoinType() == JoinType::LEFT;
+    outer_idx_++;
+    matched_ = false;
+    if (pad) {
+      *tuple = Tuple::Concat(outer, outer_schema, null_inner_, inner_schema);
+      return true;
+    }
+  }
+}
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!Produce(tuple)) {
+    return false;
+  }
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto NestIndexJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  Tuple tuple;
+  while (!batch->IsFull() && Produce(&tuple)) {
+    batch->Append(std::move(tuple), RID{});
+  }
+  return !batch->IsEmpty();
+}
 
 }  // namespace bustub
@@ -22,60 +22,100 @@ NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       left_exector_(std::move(left_executor)),
-      right_executor_(std::move(right_executor)) {}
+      right_executor_(std::move(right_executor)),
+      left_block_(exec_ctx->GetJoinBlockSize()) {
+  program_ = CompiledExpression::CompileJoin(plan_->Predicate(), left_exector_->GetOutputSchema(),
+                                             right_executor_->GetOutputSchema());
+}
 
 void NestedLoopJoinExecutor::Init() {
   left_exector_->Init();
   right_executor_->Init();
-  Tuple tuple;
-  RID rid;
-  std::vector<Tuple> left_tuples, right_tuples;
-  auto left_schema = left_exector_->GetOutputSchema();
-  auto right_schema = right_executor_->GetOutputSchema();
-  while (left_exector_->Next(&tuple, &rid)) {
-    left_tuples.push_back(tuple);
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  BUSTUB_ASSERT(plan_->OutputSchema().GetLength() == left_exector_->GetOutputSchema().GetLength() +
+                                                         right_schema.GetLength(),
+                "the output must be the columns of the left side followed by those of the right side");
+
+  right_tuples_.clear();
+  TupleBatch batch;
+  while (right_executor_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      right_tuples_.push_back(std::move(batch.GetTuple(i)));
+    }
   }
-  while (right_executor_->Next(&tuple, &rid)) {
-    right_tuples.push_back(tuple);
+  if (plan_->GetJoinType() == JoinType::LEFT) {
+    std::vector<Value> nulls;
+    for (const auto &column : right_schema.GetColumns()) {
+      nulls.push_back(ValueFactory::GetNullValueByType(column.GetType()));
+    }
+    null_right_ = Tuple(nulls, &right_schema);
   }
-  for (auto &left_tuple : left_tuples) {
-    bool is_left_join_valid = false;
-    for (auto &right_tuple : right_tuples) {
-      auto join_result = plan_->Predicate().EvaluateJoin(&left_tuple, left_schema, &right_tuple, right_schema);
-      if (!join_result.IsNull() && join_result.GetAs<bool>()) {
-        is_left_join_valid = true;
 
-        std::vector<Value> values;
-        for (size_t i = 0; i < left_schema.GetColumns().size(); i++) {
-          values.push_back(left_tuple.GetValue(&left_schema, i));
-        }
-        for (size_t i = 0; i < right_schema.GetColumns().size(); i++) {
-          values.push_back(right_tuple.GetValue(&right_schema, i));
-        }
-        result_tuples_.push_back(Tuple(values, &plan_->OutputSchema()));
+  left_block_.Reset();
+  left_idx_ = 0;
+  left_exhausted_ = false;
+  right_idx_ = 0;
+  matched_ = false;
+}
+
+auto NestedLoopJoinExecutor::Matches(const Tuple &left_tuple, const Tuple &right_tuple) const -> bool {
+  auto join_result = plan_->Predicate().EvaluateJoin(&left_tuple, left_exector_->GetOutputSchema(), &right_tuple,
+                                                     right_executor_->GetOutputSchema());
+  return !join_result.IsNull() && join_result.GetAs<bool>();
+}
+
+auto NestedLoopJoinExecutor::Produce(Tuple *tuple) -> bool {
+  const auto &left_schema = left_exector_->GetOutputSchema();
+  const auto &right_schema = right_executor_->GetOutputSchema();
+  while (true) {
+    if (left_idx_ == left_block_.Size()) {
+      // An inner join with an empty right side has no output, so the left side need not be read at all.
+      if (left_exhausted_ || (right_tuples_.empty() && plan_->GetJoinType() == JoinType::INNER)) {
+        return false;
       }
-    }
-    if (!is_left_join_valid && plan_->GetJoinType() == JoinType::LEFT) {
-      std::vector<Value> values;
-      for (size_t i = 0; i < left_schema.GetColumns().size(); i++) {
-        values.push_back(left_tuple.GetValue(&left_schema, i));
+      left_idx_ = 0;
+      if (!left_exector_->NextBatch(&left_block_)) {
+        left_exhausted_ = true;
+        return false;
       }
-      for (size_t i = 0; i < right_schema.GetColumns().size(); i++) {
-        values.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(i).GetType()));
+    }
+    const Tuple &left_tuple = left_block_.GetTuple(left_idx_);
+    while (right_idx_ < right_tuples_.size()) {
+      const Tuple &right_tuple = right_tuples_[right_idx_++];
+      const bool match = program_ != nullptr ? program_->EvaluatePredicate(&left_tuple, &right_tuple)
+                                             : Matches(left_tuple, right_tuple);
+      if (match) {
+        matched_ = true;
+        *tuple = Tuple::Concat(left_tuple, left_schema, right_tuple, right_schema);
+        return true;
       }
-      result_tuples_.push_back(Tuple(values, &plan_->OutputSchema()));
+    }
+    const bool pad = !matched_ && plan_->GetJoinType() == JoinType::LEFT;
+    left_idx_++;
+    right_idx_ = 0;
+    matched_ = false;
+    if (pad) {
+      *tuple = Tuple::Concat(left_tuple, left_schema, null_right_, right_schema);
+      return true;
     }
   }
 }
 
 auto NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (result_tuples_.empty()) {
+  if (!Produce(tuple)) {
     return false;
   }
-  *tuple = result_tuples_.front();
-  result_tuples_.pop_front();
   *rid = tuple->GetRid();
   return true;
 }
 
+auto NestedLoopJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  Tuple tuple;
+  while (!batch->IsFull() && Produce(&tuple)) {
+    batch->Append(std::move(tuple), RID{});
+  }
+  return !batch->IsEmpty();
+}
+
 }  // namespace bustub
@@ -5,7 +5,11 @@ namespace bustub {
 
 ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const ProjectionPlanNode *plan,
                                        std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {
+  for (const auto &expr : plan_->GetExpressions()) {
+    programs_.push_back(CompiledExpression::Compile(*expr, child_executor_->GetOutputSchema()));
+  }
+}
 
 void ProjectionExecutor::Init() {
   // Initialize the child executor
@@ -25,12 +29,50 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   // Compute expressions
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
-  for (const auto &expr : plan_->GetExpressions()) {
-    values.push_back(expr->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
+  const auto &exprs = plan_->GetExpressions();
+  for (size_t j = 0; j < exprs.size(); j++) {
+    values.push_back(programs_[j] != nullptr ? programs_[j]->Evaluate(&child_tuple)
+                                             : exprs[j]->Evaluate(&child_tuple, child_executor_->GetOutputSchema()));
   }
 
   *tuple = Tuple{values, &GetOutputSchema()};
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  if (!child_executor_->NextBatch(&child_batch_)) {
+    return false;
+  }
+
+  // Compute every expression column-wise where it has vector kernels, row by row through its bytecode otherwise, and
+  // only fall back to walking the expression tree if it does not compile either.
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  const auto &exprs = plan_->GetExpressions();
+  chunk_.Reset(&child_batch_, &child_schema);
+  columns_.resize(exprs.size());
+  vectorized_.resize(exprs.size());
+  for (size_t j = 0; j < exprs.size(); j++) {
+    vectorized_[j] = exprs[j]->EvaluateVector(chunk_, &columns_[j]);
+  }
+
+  std::vector<Value> values{};
+  values.reserve(GetOutputSchema().GetColumnCount());
+  for (size_t i = 0; i < child_batch_.Size(); i++) {
+    const Tuple &child_tuple = child_batch_.GetTuple(i);
+    values.clear();
+    for (size_t j = 0; j < exprs.size(); j++) {
+      if (vectorized_[j]) {
+        values.push_back(columns_[j].GetValue(i));
+      } else if (programs_[j] != nullptr) {
+        values.push_back(programs_[j]->Evaluate(&child_tuple));
+      } else {
+        values.push_back(exprs[j]->Evaluate(&child_tuple, child_schema));
+      }
+    }
+    batch->Append(Tuple{values, &GetOutputSchema()}, child_batch_.GetRid(i));
+  }
+  return true;
+}
 }  // namespace bustub
@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.cpp
+//
+// Identification: src/execution/runtime_filter.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/runtime_filter.h"
+
+namespace bustub {
+
+void RuntimeFilter::Build(const std::vector<int64_t> &keys) {
+  const size_t bits = keys.size() * BITS_PER_KEY;
+  const size_t block_bits = sizeof(Block) * 8;
+  blocks_.assign((bits + block_bits - 1) / block_bits, Block{});
+  for (const int64_t key : keys) {
+    const uint64_t hash = HashUtil::MixHash(static_cast<uint64_t>(key));
+    Block &block = blocks_[BlockOf(hash)];
+    const auto low = static_cast<uint32_t>(hash);
+    for (size_t i = 0; i < WORDS_PER_BLOCK; i++) {
+      block.words_[i] |= BitOf(low, i);
+    }
+  }
+  built_ = true;
+}
+
+}  // namespace bustub
@@ -0,0 +1,241 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// scan_predicate.cpp
+//
+// Identification: src/execution/scan_predicate.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/scan_predicate.h"
+
+#include <cstring>
+#include <functional>
+
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+/** @brief Append the operands of the top-level ANDs of the expression. */
+void SplitConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+      logic != nullptr && logic->logic_type_ == LogicType::And) {
+    SplitConjuncts(logic->GetChildAt(0), conjuncts);
+    SplitConjuncts(logic->GetChildAt(1), conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+/** @return The comparison that gives the same result with its operands swapped */
+auto Mirror(ComparisonType type) -> ComparisonType {
+  switch (type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return type;
+  }
+}
+
+template <typename T>
+constexpr auto NullOf() -> T;
+template <>
+constexpr auto NullOf<int8_t>() -> int8_t {
+  return BUSTUB_INT8_NULL;
+}
+template <>
+constexpr auto NullOf<int16_t>() -> int16_t {
+  return BUSTUB_INT16_NULL;
+}
+template <>
+constexpr auto NullOf<int32_t>() -> int32_t {
+  return BUSTUB_INT32_NULL;
+}
+template <>
+constexpr auto NullOf<int64_t>() -> int64_t {
+  return BUSTUB_INT64_NULL;
+}
+
+template <typename T, typename Op>
+auto CompareColumn(const char *data, uint32_t offset, int64_t constant) -> bool {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value != NullOf<T>() && Op{}(static_cast<int64_t>(value), constant);
+}
+
+using CompareFn = auto (*)(const char *data, uint32_t offset, int64_t constant) -> bool;
+
+template <typename T>
+auto KernelFor(ComparisonType type) -> CompareFn {
+  switch (type) {
+    case ComparisonType::Equal:
+      return &CompareColumn<T, std::equal_to<>>;
+    case ComparisonType::NotEqual:
+      return &CompareColumn<T, std::not_equal_to<>>;
+    case ComparisonType::LessThan:
+      return &CompareColumn<T, std::less<>>;
+    case ComparisonType::LessThanOrEqual:
+      return &CompareColumn<T, std::less_equal<>>;
+    case ComparisonType::GreaterThan:
+      return &CompareColumn<T, std::greater<>>;
+    case ComparisonType::GreaterThanOrEqual:
+      return &CompareColumn<T, std::greater_equal<>>;
+  }
+  return nullptr;
+}
+
+template <typename T>
+auto ReadKey(const char *data, uint32_t offset) -> int64_t {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value == NullOf<T>() ? INT64_MIN : static_cast<int64_t>(value);
+}
+
+auto ConstantAsInt64(const Value &value, int64_t *out) -> bool {
+  if (value.IsNull()) {
+    return false;
+  }
+  switch (value.GetTypeId()) {
+    case TypeId::TINYINT:
+      *out = value.GetAs<int8_t>();
+      return true;
+    case TypeId::SMALLINT:
+      *out = value.GetAs<int16_t>();
+      return true;
+    case TypeId::INTEGER:
+      *out = value.GetAs<int32_t>();
+      return true;
+    case TypeId::BIGINT:
+      *out = value.GetAs<int64_t>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+ScanPredicate::ScanPredicate(const AbstractExpressionRef &predicate, const Schema *schema) : schema_(schema) {
+  if (predicate == nullptr) {
+    return;
+  }
+  std::vector<AbstractExpressionRef> conjuncts;
+  SplitConjuncts(predicate, &conjuncts);
+  for (const auto &conjunct : conjuncts) {
+    if (AddKernel(*conjunct)) {
+      continue;
+    }
+    residual_ =
+        residual_ == nullptr ? conjunct : std::make_shared<LogicExpression>(residual_, conjunct, LogicType::And);
+  }
+  if (residual_ != nullptr) {
+    residual_program_ = CompiledExpression::Compile(*residual_, *schema_);
+  }
+}
+
+auto ScanPredicate::AddKernel(const AbstractExpression &conjunct) -> bool {
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(&conjunct);
+  if (comparison == nullptr) {
+    return false;
+  }
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get());
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1).get());
+  ComparisonType type = comparison->comp_type_;
+  if (column == nullptr) {
+    column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1).get());
+    constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0).get());
+    type = Mirror(type);
+  }
+  int64_t value;
+  // A NULL constant makes the comparison NULL for every tuple; leave that to the residual.
+  if (column == nullptr || constant == nullptr || column->GetColIdx() >= schema_->GetColumnCount() ||
+      !ConstantAsInt64(constant->val_, &value)) {
+    return false;
+  }
+  const Column &col = schema_->GetColumn(column->GetColIdx());
+  KernelFn fn = nullptr;
+  switch (col.GetType()) {
+    case TypeId::TINYINT:
+      fn = KernelFor<int8_t>(type);
+      break;
+    case TypeId::SMALLINT:
+      fn = KernelFor<int16_t>(type);
+      break;
+    case TypeId::INTEGER:
+      fn = KernelFor<int32_t>(type);
+      break;
+    case TypeId::BIGINT:
+      fn = KernelFor<int64_t>(type);
+      break;
+    default:
+      break;
+  }
+  if (fn == nullptr) {
+    return false;
+  }
+  kernels_.push_back(Kernel{fn, col.GetOffset(), value});
+  return true;
+}
+
+auto ScanPredicate::Matches(const TupleView &view) const -> bool {
+  for (const auto &kernel : kernels_) {
+    if (!kernel.fn_(view.GetData(), kernel.offset_, kernel.constant_)) {
+      return false;
+    }
+  }
+  if (residual_ == nullptr) {
+    return true;
+  }
+  if (residual_program_ != nullptr) {
+    return residual_program_->EvaluatePredicate(&view.AsTuple());
+  }
+  Value value = residual_->Evaluate(&view.AsTuple(), *schema_);
+  return !value.IsNull() && value.GetAs<bool>();
+}
+
+auto IntegerColumnReaderFor(TypeId type) -> IntegerColumnReader {
+  switch (type) {
+    case TypeId::TINYINT:
+      return &ReadKey<int8_t>;
+    case TypeId::SMALLINT:
+      return &ReadKey<int16_t>;
+    case TypeId::INTEGER:
+      return &ReadKey<int32_t>;
+    case TypeId::BIGINT:
+      return &ReadKey<int64_t>;
+    default:
+      return nullptr;
+  }
+}
+
+ScanThreshold::ScanThreshold(const Column &column, bool descending)
+    : read_(IntegerColumnReaderFor(column.GetType())), offset_(column.GetOffset()), descending_(descending) {
+  BUSTUB_ASSERT(read_ != nullptr, "threshold keys must be integers");
+}
+
+void ScanThreshold::Update(const Value &key) {
+  if (key.IsNull()) {
+    bound_ = INT64_MIN;
+  } else {
+    BUSTUB_ENSURE(ConstantAsInt64(key, &bound_), "threshold keys must be integers");
+  }
+  active_ = true;
+}
+
+}  // namespace bustub
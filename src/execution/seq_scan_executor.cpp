@@ -12,26 +12,120 @@
 
 #include "execution/executors/seq_scan_executor.h"
 
+#include <utility>
+
 namespace bustub {
 
 SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx), plan_(plan), table_iterator_(nullptr, RID(), nullptr) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      table_info_(exec_ctx->GetCatalog()->GetTable(plan->GetTableOid())),
+      predicate_(plan->filter_predicate_, &table_info_->schema_) {}
 
 void SeqScanExecutor::Init() {
-  table_info_ = exec_ctx_->GetCatalog()->GetTable(plan_->GetTableOid());
   table_heap_ = table_info_->table_.get();
-  table_iterator_ = table_heap_->Begin(exec_ctx_->GetTransaction());
+  dispenser_ = exec_ctx_->GetMorselDispenser(plan_);
+  threshold_ = exec_ctx_->GetScanThreshold(plan_);
+  runtime_filter_ = nullptr;
+  if (plan_->runtime_filter_.has_value()) {
+    const RuntimeFilter *filter = exec_ctx_->GetRuntimeFilter(*plan_->runtime_filter_);
+    const Column &column = table_info_->schema_.GetColumn(plan_->runtime_filter_column_);
+    runtime_filter_read_ = IntegerColumnReaderFor(column.GetType());
+    runtime_filter_offset_ = column.GetOffset();
+    if (filter != nullptr && filter->IsBuilt() && runtime_filter_read_ != nullptr) {
+      runtime_filter_ = filter;
+    }
+  }
+  emitted_ = 0;
+  morsel_.clear();
+  morsel_idx_ = 0;
+  page_.Release();
+  has_rid_ = false;
+  next_page_id_ = table_heap_->GetFirstPageId();
 };
 
-auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-    if(table_iterator_==table_heap_->End())
-    {
+auto SeqScanExecutor::PinNextPage() -> bool {
+  page_id_t page_id;
+  if (dispenser_ != nullptr) {
+    if (morsel_idx_ == morsel_.size()) {
+      morsel_idx_ = 0;
+      if (!dispenser_->Next(&morsel_)) {
         return false;
+      }
+    }
+    page_id = morsel_[morsel_idx_++];
+  } else {
+    if (next_page_id_ == INVALID_PAGE_ID) {
+      return false;
+    }
+    page_id = std::exchange(next_page_id_, INVALID_PAGE_ID);
+  }
+  page_ = table_heap_->PinPage(page_id);
+  TablePage *page = page_.GetPage();
+  page->RLatch();
+  has_rid_ = page->GetFirstTupleRid(&rid_);
+  page->RUnlatch();
+  return true;
+}
+
+template <typename Emit>
+auto SeqScanExecutor::Scan(Emit &&emit) -> bool {
+  size_t skipped = 0;
+  size_t pruned = 0;
+  bool full = false;
+  while (!full && !LimitReached() && (page_.IsValid() || PinNextPage())) {
+    TablePage *page = page_.GetPage();
+    page->RLatch();
+    while (has_rid_ && !full) {
+      TupleView view;
+      if (page->GetTupleView(rid_, &view)) {
+        if (runtime_filter_ != nullptr && !MayJoin(view)) {
+          pruned++;
+        } else if (threshold_ != nullptr && !threshold_->Passes(view)) {
+          skipped++;
+        } else if (predicate_.Matches(view)) {
+          emitted_++;
+          full = !emit(view) || LimitReached();
+        }
+      }
+      has_rid_ = page->GetNextTupleRid(rid_, &rid_);
     }
-    *tuple=*table_iterator_;
-    *rid=tuple->GetRid();
-    ++table_iterator_;
-    return true;
+    if (!has_rid_ && dispenser_ == nullptr) {
+      // Read the link only now, so that pages appended while this one was read are not missed.
+      next_page_id_ = page->GetNextPageId();
+    }
+    page->RUnlatch();
+    if (!has_rid_ || LimitReached()) {
+      page_.Release();
+    }
+  }
+  if (pruned > 0) {
+    exec_ctx_->AddStat(plan_, "runtime_filter_pruned_tuples", pruned);
+  }
+  if (skipped > 0) {
+    exec_ctx_->AddStat(plan_, "threshold_skipped_tuples", skipped);
+  }
+  return full;
+}
+
+auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  bool found = Scan([&](const TupleView &view) {
+    view.MaterializeInto(tuple);
+    return false;
+  });
+  if (found) {
+    *rid = tuple->GetRid();
+  }
+  return found;
+}
+
+auto SeqScanExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Reset();
+  Scan([&](const TupleView &view) {
+    batch->Append(view);
+    return !batch->IsFull();
+  });
+  return !batch->IsEmpty();
 }
 
 }  // namespace bustub
@@ -4,59 +4,144 @@ namespace bustub {
 
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan->GetOrderBy(), plan->OutputSchema()) {}
 
-void SortExecutor::Init() {
-  child_executor_->Init();
-  Tuple child_tuple;
-  RID child_rid;
-  while (child_executor_->Next(&child_tuple, &child_rid)) {
-    tuples_.push_back(child_tuple);
+void SortExecutor::SortTuples() {
+  auto order = encoder_.SortPermutation(tuples_);
+  std::vector<Tuple> sorted;
+  sorted.reserve(tuples_.size());
+  for (auto idx : order) {
+    sorted.push_back(std::move(tuples_[idx]));
   }
+  tuples_ = std::move(sorted);
+}
 
-  auto order_bys = plan_->GetOrderBy();
-  auto child_schema = plan_->OutputSchema();
-
-  auto cmp = [&](const Tuple &left_tuple, const Tuple &right_tuple) -> bool {
-    bool result = false;
-    for (auto order_by : order_bys) {
-      auto sort_type = order_by.first;
-      auto left_predict = order_by.second;
-      auto left_value = left_predict->Evaluate(&left_tuple, child_schema);
-      auto right_value = left_predict->Evaluate(&right_tuple, child_schema);
+void SortExecutor::Init() {
+  child_executor_->Init();
+  tuples_.clear();
+  cursor_ = 0;
+  runs_.clear();
+  heap_.clear();
 
-      CmpBool cmp_result = CmpBool::CmpNull;
-      if (left_value.CompareEquals(right_value) == CmpBool::CmpTrue) {
-        continue;
-      }
-      if (sort_type == OrderByType::DESC) {
-        // std::cout << "DESC:" << left_value.ToString() << " " << right_value.ToString() << std::endl;
-        cmp_result = left_value.CompareGreaterThan(right_value);
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  const size_t budget = exec_ctx_->GetMemoryBudget();
+  size_t buffered_bytes = 0;
+  // The tuples of the first run are copied into the query arena, which leaves the buffers of the batch to be reused.
+  // Rescans and the runs after the first spill allocate them on their own, so that the arena does not grow with them.
+  Arena *arena = initialized_ ? nullptr : exec_ctx_->GetArena();
+  initialized_ = true;
+  TupleBatch batch;
+  while (child_executor_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      Tuple &tuple = batch.GetTuple(i);
+      buffered_bytes += sizeof(Tuple) + tuple.GetLength();
+      if (arena != nullptr) {
+        tuples_.emplace_back(tuple, arena);
       } else {
-        // std::cout << "ASC:" << left_value.ToString() << " " << right_value.ToString() << std::endl;
-        cmp_result = left_value.CompareLessThan(right_value);
+        tuples_.push_back(std::move(tuple));
       }
-      if (cmp_result == CmpBool::CmpTrue) {
-        result = true;
-        break;
-      } else if (cmp_result == CmpBool::CmpFalse) {
-        result = false;
-        break;
+      if (buffered_bytes > budget && bpm != nullptr) {
+        SpillRun();
+        buffered_bytes = 0;
+        arena = nullptr;
       }
     }
-    return result;
-  };
+  }
 
-  std::sort(tuples_.begin(), tuples_.end(), cmp);
-  std::reverse(tuples_.begin(), tuples_.end());
+  if (runs_.empty()) {
+    SortTuples();
+    return;
+  }
+  if (!tuples_.empty()) {
+    SpillRun();
+  }
+
+  // Merge passes until the remaining runs can be merged at once. Each pass merges the oldest runs into a new one, so
+  // equal tuples keep their input order.
+  size_t first_run = 0;
+  while (runs_.size() - first_run > MERGE_FANOUT) {
+    size_t end = first_run + MERGE_FANOUT;
+    StartMerge(first_run, end);
+    auto merged = std::make_unique<TmpTupleFile>(bpm);
+    Tuple tuple;
+    while (PopMerge(&tuple)) {
+      merged->Append(tuple);
+    }
+    merged->FinishWrite();
+    for (size_t i = first_run; i < end; i++) {
+      runs_[i].reset();
+    }
+    runs_.push_back(std::move(merged));
+    first_run = end;
+    exec_ctx_->AddStat(plan_, "intermediate_merges", 1);
+  }
+  StartMerge(first_run, runs_.size());
 }
 
-auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (tuples_.empty()) {
+void SortExecutor::SpillRun() {
+  SortTuples();
+  auto run = std::make_unique<TmpTupleFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &tuple : tuples_) {
+    run->Append(tuple);
+  }
+  run->FinishWrite();
+  exec_ctx_->AddStat(plan_, "spilled_runs", 1);
+  exec_ctx_->AddStat(plan_, "spilled_tuples", run->Size());
+  runs_.push_back(std::move(run));
+  tuples_.clear();
+}
+
+auto SortExecutor::MergeAfter(const MergeEntry &left, const MergeEntry &right) const -> bool {
+  int cmp = SortKeyEncoder::Compare(left.key_, right.key_);
+  return cmp > 0 || (cmp == 0 && left.run_ > right.run_);
+}
+
+void SortExecutor::StartMerge(size_t begin, size_t end) {
+  heap_.clear();
+  for (size_t run = begin; run < end; run++) {
+    MergeEntry entry;
+    runs_[run]->Rewind();
+    if (runs_[run]->Next(&entry.tuple_)) {
+      encoder_.EncodeKey(entry.tuple_, &entry.key_);
+      entry.run_ = run;
+      heap_.push_back(std::move(entry));
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(),
+                 [this](const MergeEntry &left, const MergeEntry &right) { return MergeAfter(left, right); });
+}
+
+auto SortExecutor::PopMerge(Tuple *tuple) -> bool {
+  if (heap_.empty()) {
     return false;
   }
-  *tuple = tuples_.back();
-  tuples_.pop_back();
+  auto after = [this](const MergeEntry &left, const MergeEntry &right) { return MergeAfter(left, right); };
+  std::pop_heap(heap_.begin(), heap_.end(), after);
+  auto &top = heap_.back();
+  *tuple = std::move(top.tuple_);
+  if (runs_[top.run_]->Next(&top.tuple_)) {
+    encoder_.EncodeKey(top.tuple_, &top.key_);
+    std::push_heap(heap_.begin(), heap_.end(), after);
+  } else {
+    heap_.pop_back();
+  }
+  return true;
+}
+
+auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  if (!runs_.empty()) {
+    if (!PopMerge(tuple)) {
+      return false;
+    }
+  } else {
+    if (cursor_ == tuples_.size()) {
+      return false;
+    }
+    *tuple = std::move(tuples_[cursor_++]);
+  }
   *rid = tuple->GetRid();
   return true;
 }
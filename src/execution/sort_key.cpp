@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <numeric>
+
+#include "common/macros.h"
+#include "storage/index/normalized_key.h"
+
+namespace bustub {
+
+void SortKeyEncoder::Encode(const Tuple &tuple, std::vector<uint8_t> *out) const {
+  for (size_t i = 0; i < order_bys_.size(); i++) {
+    const auto &[order_by_type, expr] = order_bys_[i];
+    size_t begin = out->size();
+    Value value = programs_[i] != nullptr ? programs_[i]->Evaluate(&tuple) : expr->Evaluate(&tuple, schema_);
+    NormalizedKey::AppendValue(value, out);
+    if (order_by_type == OrderByType::DESC) {
+      // NormalizedKey encodings are prefix-free, so the first differing byte of two keys lies within both of them and
+      // inverting the bytes inverts their order.
+      for (size_t j = begin; j < out->size(); j++) {
+        (*out)[j] = ~(*out)[j];
+      }
+    }
+  }
+}
+
+auto SortKeyEncoder::SortPermutation(const std::vector<Tuple> &tuples) const -> std::vector<uint32_t> {
+  BUSTUB_ASSERT(tuples.size() < UINT32_MAX, "too many tuples to sort");
+  std::vector<uint8_t> keys;
+  std::vector<size_t> offsets;
+  offsets.reserve(tuples.size() + 1);
+  offsets.push_back(0);
+  // Keys without VARCHARs all have the same width, which saves the length bookkeeping in the comparator.
+  bool fixed_width = true;
+  for (const auto &tuple : tuples) {
+    Encode(tuple, &keys);
+    offsets.push_back(keys.size());
+    fixed_width = fixed_width && offsets.back() - offsets[offsets.size() - 2] == offsets[1];
+  }
+
+  std::vector<uint32_t> order(tuples.size());
+  std::iota(order.begin(), order.end(), 0);
+  const uint8_t *data = keys.data();
+  if (fixed_width) {
+    const size_t width = tuples.empty() ? 0 : offsets[1];
+    std::sort(order.begin(), order.end(), [data, width](uint32_t left, uint32_t right) {
+      int cmp = memcmp(data + left * width, data + right * width, width);
+      return cmp < 0 || (cmp == 0 && left < right);
+    });
+  } else {
+    std::sort(order.begin(), order.end(), [data, &offsets](uint32_t left, uint32_t right) {
+      int cmp = Compare(data + offsets[left], offsets[left + 1] - offsets[left], data + offsets[right],
+                        offsets[right + 1] - offsets[right]);
+      return cmp < 0 || (cmp == 0 && left < right);
+    });
+  }
+  return order;
+}
+
+}  // namespace bustub
@@ -1,66 +1,83 @@
 #include "execution/executors/topn_executor.h"
 
+#include "execution/expressions/column_value_expression.h"
+
 namespace bustub {
 
 TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
                            std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      encoder_(plan->GetOrderBy(), plan->OutputSchema()) {
+  const auto &child_plan = plan_->GetChildPlan();
+  if (child_plan->GetType() != PlanType::SeqScan || plan_->GetOrderBy().empty()) {
+    return;
+  }
+  const auto &[order_by_type, expr] = plan_->GetOrderBy()[0];
+  const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+  if (column_expr == nullptr || column_expr->GetColIdx() >= child_plan->OutputSchema().GetColumnCount()) {
+    return;
+  }
+  const Column &column = child_plan->OutputSchema().GetColumn(column_expr->GetColIdx());
+  if (ScanThreshold::Supports(column)) {
+    threshold_ = std::make_unique<ScanThreshold>(column, order_by_type == OrderByType::DESC);
+    exec_ctx_->SetScanThreshold(child_plan.get(), threshold_.get());
+  }
+}
+
+void TopNExecutor::UpdateThreshold() {
+  if (threshold_ != nullptr) {
+    threshold_->Update(plan_->GetOrderBy()[0].second->Evaluate(&entries_.front().tuple_, plan_->OutputSchema()));
+  }
+}
 
 void TopNExecutor::Init() {
+  if (threshold_ != nullptr) {
+    threshold_->Reset();
+  }
   child_executor_->Init();
-  auto order_bys = plan_->GetOrderBy();
-  auto child_schema = plan_->OutputSchema();
-
-  auto cmp = [&](const Tuple &left_tuple, const Tuple &right_tuple) -> bool {
-    bool result = false;
-    for (auto order_by : order_bys) {
-      auto sort_type = order_by.first;
-      auto left_predict = order_by.second;
-      auto left_value = left_predict->Evaluate(&left_tuple, child_schema);
-      auto right_value = left_predict->Evaluate(&right_tuple, child_schema);
+  entries_.clear();
+  cursor_ = 0;
+  const size_t n = plan_->GetN();
 
-      CmpBool cmp_result = CmpBool::CmpNull;
-      if (left_value.CompareEquals(right_value) == CmpBool::CmpTrue) {
+  Entry candidate;
+  candidate.seq_ = 0;
+  TupleBatch batch;
+  while (child_executor_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++, candidate.seq_++) {
+      if (n == 0) {
         continue;
       }
-      if (sort_type == OrderByType::DESC) {
-        // std::cout << "DESC:" << left_value.ToString() << " " << right_value.ToString() << std::endl;
-        cmp_result = left_value.CompareGreaterThan(right_value);
-      } else {
-        // std::cout << "ASC:" << left_value.ToString() << " " << right_value.ToString() << std::endl;
-        cmp_result = left_value.CompareLessThan(right_value);
+      encoder_.EncodeKey(batch.GetTuple(i), &candidate.key_);
+      if (entries_.size() < n) {
+        candidate.tuple_ = std::move(batch.GetTuple(i));
+        entries_.push_back(std::move(candidate));
+        std::push_heap(entries_.begin(), entries_.end(), Before);
+        if (entries_.size() == n) {
+          UpdateThreshold();
+        }
+        continue;
       }
-      if (cmp_result == CmpBool::CmpTrue) {
-        result = true;
-        break;
-      } else if (cmp_result == CmpBool::CmpFalse) {
-        result = false;
-        break;
+      if (Before(candidate, entries_.front())) {
+        // Replace the largest of the top N.
+        std::pop_heap(entries_.begin(), entries_.end(), Before);
+        std::swap(entries_.back().key_, candidate.key_);
+        entries_.back().seq_ = candidate.seq_;
+        entries_.back().tuple_ = std::move(batch.GetTuple(i));
+        std::push_heap(entries_.begin(), entries_.end(), Before);
+        UpdateThreshold();
       }
     }
-    return result;
-  };
-  std::priority_queue<Tuple, std::vector<Tuple>, decltype(cmp)> pq(cmp);
-  Tuple child_tuple;
-  RID child_rid;
-  while (child_executor_->Next(&child_tuple, &child_rid)) {
-    pq.push(child_tuple);
-    while (pq.size() > (plan_->GetN())) {
-      pq.pop();
-    }
-  }
-  while (!pq.empty()) {
-    tuples_.push_back(pq.top());
-    pq.pop();
   }
+  std::sort_heap(entries_.begin(), entries_.end(), Before);
 }
 
 auto TopNExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (tuples_.empty()) {
+  if (cursor_ == entries_.size()) {
     return false;
   }
-  *tuple = tuples_.back();
-  tuples_.pop_back();
+  *tuple = std::move(entries_[cursor_++].tuple_);
   *rid = tuple->GetRid();
   return true;
 }
@@ -12,17 +12,119 @@
 #include <memory>
 
 #include "execution/executors/update_executor.h"
+#include "execution/expressions/column_value_expression.h"
 
 namespace bustub {
 
+namespace {
+
+/** @return true if the keys have the same value in every column, NULLs included */
+auto SameKey(const Tuple &left, const Tuple &right, const Schema &key_schema) -> bool {
+  for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+    Value left_value = left.GetValue(&key_schema, i);
+    Value right_value = right.GetValue(&key_schema, i);
+    if (left_value.IsNull() || right_value.IsNull()) {
+      if (left_value.IsNull() != right_value.IsNull()) {
+        return false;
+      }
+    } else if (left_value.CompareEquals(right_value) != CmpBool::CmpTrue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 UpdateExecutor::UpdateExecutor(ExecutorContext *exec_ctx, const UpdatePlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
-  // As of Fall 2022, you DON'T need to implement update executor to have perfect score in project 3 / project 4.
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      table_info_(exec_ctx->GetCatalog()->GetTable(plan->TableOid())),
+      child_executor_(std::move(child_executor)) {}
+
+void UpdateExecutor::Init() {
+  child_executor_->Init();
+  has_updated_ = false;
+  indexes_ = exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->name_);
+  key_assigned_.clear();
+  for (auto index : indexes_) {
+    bool assigned = false;
+    for (auto col : index->index_->GetMetadata()->GetKeyAttrs()) {
+      const auto *column = dynamic_cast<const ColumnValueExpression *>(plan_->target_expressions_[col].get());
+      assigned = assigned || column == nullptr || column->GetTupleIdx() != 0 || column->GetColIdx() != col;
+    }
+    key_assigned_.push_back(assigned);
+  }
 }
 
-void UpdateExecutor::Init() { throw NotImplementedException("UpdateExecutor is not implemented"); }
+auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
+  if (has_updated_) {
+    return false;
+  }
+  has_updated_ = true;
+  auto *txn = exec_ctx_->GetTransaction();
+  const auto &child_schema = child_executor_->GetOutputSchema();
+  const auto &schema = table_info_->schema_;
 
-auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool { return false; }
+  // Collect the tuples before updating any: a moved tuple must not come up in the scan again, and an index scan must
+  // not have its index changed underneath it.
+  std::vector<Tuple> old_tuples;
+  std::vector<RID> rids;
+  TupleBatch batch;
+  while (child_executor_->NextBatch(&batch)) {
+    for (size_t i = 0; i < batch.Size(); i++) {
+      old_tuples.push_back(std::move(batch.GetTuple(i)));
+      rids.push_back(batch.GetRid(i));
+    }
+  }
+
+  size_t in_place = 0;
+  size_t moved = 0;
+  size_t index_updates = 0;
+  std::vector<Value> values;
+  for (size_t i = 0; i < old_tuples.size(); i++) {
+    values.clear();
+    for (const auto &expr : plan_->target_expressions_) {
+      values.push_back(expr->Evaluate(&old_tuples[i], child_schema));
+    }
+    Tuple new_tuple{values, &schema};
+    RID new_rid = rids[i];
+    if (table_info_->table_->UpdateTuple(new_tuple, rids[i], txn)) {
+      in_place++;
+    } else {
+      // The new version does not fit into the page of the old one.
+      if (!table_info_->table_->MarkDelete(rids[i], txn) ||
+          !table_info_->table_->InsertTuple(new_tuple, &new_rid, txn)) {
+        throw ExecutionException("update failed: could not move the tuple");
+      }
+      moved++;
+    }
+
+    for (size_t j = 0; j < indexes_.size(); j++) {
+      bool moved_tuple = !(new_rid == rids[i]);
+      if (!moved_tuple && !key_assigned_[j]) {
+        continue;
+      }
+      const auto &key_schema = indexes_[j]->key_schema_;
+      const auto &key_attrs = indexes_[j]->index_->GetMetadata()->GetKeyAttrs();
+      Tuple old_key = old_tuples[i].KeyFromTuple(schema, key_schema, key_attrs);
+      Tuple new_key = new_tuple.KeyFromTuple(schema, key_schema, key_attrs);
+      if (!moved_tuple && SameKey(old_key, new_key, key_schema)) {
+        continue;
+      }
+      indexes_[j]->index_->DeleteEntry(old_key, rids[i], txn);
+      indexes_[j]->index_->InsertEntry(new_key, new_rid, txn);
+      index_updates++;
+    }
+  }
+  exec_ctx_->AddStat(plan_, "updated_in_place", in_place);
+  exec_ctx_->AddStat(plan_, "moved_tuples", moved);
+  exec_ctx_->AddStat(plan_, "index_entry_updates", index_updates);
+
+  std::vector<Value> result{Value(INTEGER, static_cast<int32_t>(old_tuples.size()))};
+  *tuple = Tuple(result, &plan_->OutputSchema());
+  return true;
+}
 
 }  // namespace bustub
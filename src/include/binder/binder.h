@@ -81,6 +81,7 @@ class ExplainStatement;
 class IndexStatement;
 class DeleteStatement;
 class UpdateStatement;
+class VacuumStatement;
 
 /**
  * The binder is responsible for transforming the Postgres parse tree to a binder tree
@@ -198,6 +199,8 @@ class Binder {
 
   auto BindUpdate(duckdb_libpgquery::PGUpdateStmt *stmt) -> std::unique_ptr<UpdateStatement>;
 
+  auto BindVacuum(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<VacuumStatement>;
+
   auto BindCTE(duckdb_libpgquery::PGWithClause *node) -> std::vector<std::unique_ptr<BoundSubqueryRef>>;
 
   auto BindVariableSet(duckdb_libpgquery::PGVariableSetStmt *stmt) -> std::unique_ptr<VariableSetStatement>;
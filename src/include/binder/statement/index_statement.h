@@ -21,7 +21,7 @@ namespace bustub {
 class IndexStatement : public BoundStatement {
  public:
   explicit IndexStatement(std::string index_name, std::unique_ptr<BoundBaseTableRef> table,
-                          std::vector<std::unique_ptr<BoundColumnRef>> cols);
+                          std::vector<std::unique_ptr<BoundColumnRef>> cols, std::string index_type);
 
   /** Name of the index */
   std::string index_name_;
@@ -32,6 +32,9 @@ class IndexStatement : public BoundStatement {
   /** Name of the columns */
   std::vector<std::unique_ptr<BoundColumnRef>> cols_;
 
+  /** Access method given in `USING`, e.g. `hash` or `btree` */
+  std::string index_type_;
+
   auto ToString() const -> std::string override;
 };
 
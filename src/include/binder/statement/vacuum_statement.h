@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/vacuum_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "binder/bound_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+
+namespace bustub {
+
+class VacuumStatement : public BoundStatement {
+ public:
+  explicit VacuumStatement(std::unique_ptr<BoundBaseTableRef> table);
+
+  std::unique_ptr<BoundBaseTableRef> table_;
+
+  auto ToString() const -> std::string override;
+};
+
+}  // namespace bustub
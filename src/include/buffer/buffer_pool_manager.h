@@ -41,8 +41,6 @@ class BufferPoolManager {
   auto FetchPage(page_id_t page_id, bufferpool_callback_fn callback = nullptr) -> Page * {
     GradingCallback(callback, CallbackType::BEFORE, page_id);
     auto *result = FetchPgImp(page_id);
-    mp[page_id]++;
-    std::cout<<"pin:"<<page_id<<std::endl;
     GradingCallback(callback, CallbackType::AFTER, page_id);
     return result;
   }
@@ -51,8 +49,6 @@ class BufferPoolManager {
   auto UnpinPage(page_id_t page_id, bool is_dirty, bufferpool_callback_fn callback = nullptr) -> bool {
     GradingCallback(callback, CallbackType::BEFORE, page_id);
     auto result = UnpinPgImp(page_id, is_dirty);
-    std::cout<<"unpin:"<<page_id<<std::endl;
-    mp[page_id]--;
     GradingCallback(callback, CallbackType::AFTER, page_id);
     return result;
   }
@@ -69,8 +65,6 @@ class BufferPoolManager {
   auto NewPage(page_id_t *page_id, bufferpool_callback_fn callback = nullptr) -> Page * {
     GradingCallback(callback, CallbackType::BEFORE, INVALID_PAGE_ID);
     auto *result = NewPgImp(page_id);
-    std::cout<<"new:"<<*page_id<<std::endl;
-    mp[*page_id]++;
     GradingCallback(callback, CallbackType::AFTER, *page_id);
     return result;
   }
@@ -90,15 +84,6 @@ class BufferPoolManager {
     GradingCallback(callback, CallbackType::AFTER, INVALID_PAGE_ID);
   }
 
-  std::map<page_id_t, int> mp;
-  void check() {
-    for (auto p : mp) {
-      if (p.second != 0) {
-        std::cout << "[" << p.first << " " << p.second << "]" << std::endl;
-      }
-    }
-  }
-
   /** @return size of the buffer pool */
   virtual auto GetPoolSize() -> size_t = 0;
 
@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena.h
+//
+// Identification: src/include/common/arena.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * Arena is a bump allocator for memory that lives as long as a query. Allocations are carved out of large chunks and
+ * never freed one by one; all chunks are released at once when the arena goes away with its ExecutorContext.
+ *
+ * The arena is a std::pmr::memory_resource, so standard containers can allocate from it as well. Allocating is
+ * lock-free except when a chunk is added, so parallel workers may share an arena.
+ */
+class Arena : public std::pmr::memory_resource {
+ public:
+  /** The default size of a chunk. */
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+  /** Every allocation is aligned to this. */
+  static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+  explicit Arena(size_t chunk_size = CHUNK_SIZE) : chunk_size_(chunk_size) {}
+
+  ~Arena() override = default;
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+
+  /** @return `bytes` bytes of memory aligned to `alignment`, valid until the arena is destroyed */
+  auto Allocate(size_t bytes, size_t alignment = ALIGNMENT) -> void *;
+
+  /** @return The number of allocations made so far */
+  auto GetAllocations() const -> size_t { return allocations_.load(std::memory_order_relaxed); }
+
+  /** @return The number of bytes requested so far */
+  auto GetAllocatedBytes() const -> size_t { return allocated_bytes_.load(std::memory_order_relaxed); }
+
+  /** @return The number of bytes taken from the system for chunks */
+  auto GetReservedBytes() const -> size_t { return reserved_bytes_.load(std::memory_order_relaxed); }
+
+  /** @return The number of chunks */
+  auto GetChunks() const -> size_t {
+    std::scoped_lock lock(latch_);
+    return chunks_.size();
+  }
+
+ protected:
+  auto do_allocate(size_t bytes, size_t alignment) -> void * override { return Allocate(bytes, alignment); }
+
+  /** Memory is only released with the whole arena. */
+  void do_deallocate(void * /*p*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+
+  auto do_is_equal(const std::pmr::memory_resource &other) const noexcept -> bool override { return this == &other; }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<char[]> data_;
+    size_t size_;
+    std::atomic<size_t> used_{0};
+  };
+
+  /** @return A new chunk of at least `size` bytes, not yet published as the current one */
+  auto NewChunk(size_t size) -> Chunk *;
+
+  /** The chunk that allocations are bumped from. */
+  std::atomic<Chunk *> current_{nullptr};
+  /** All chunks, guarded by latch_. */
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  mutable std::mutex latch_;
+  const size_t chunk_size_;
+
+  std::atomic<size_t> allocations_{0};
+  std::atomic<size_t> allocated_bytes_{0};
+  std::atomic<size_t> reserved_bytes_{0};
+};
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -266,6 +267,24 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  /** @return The memory budget in bytes of each operator, QUERY_MEMORY_BUDGET unless `query_memory_budget` is set */
+  auto GetQueryMemoryBudget() -> size_t {
+    auto variable = GetSessionVariable("query_memory_budget");
+    return variable.empty() ? QUERY_MEMORY_BUDGET : std::stoull(variable);
+  }
+
+  /** @return The number of outer tuples per nested loop join block, NLJ_BLOCK_SIZE unless `nlj_block_size` is set */
+  auto GetJoinBlockSize() -> size_t {
+    auto variable = GetSessionVariable("nlj_block_size");
+    return variable.empty() ? NLJ_BLOCK_SIZE : std::max<size_t>(std::stoull(variable), 1);
+  }
+
+  /** @return The number of worker threads of a sequential scan, PARALLEL_SCAN_THREADS unless `scan_threads` is set */
+  auto GetScanThreads() -> size_t {
+    auto variable = GetSessionVariable("scan_threads");
+    return variable.empty() ? PARALLEL_SCAN_THREADS : std::max<size_t>(std::stoull(variable), 1);
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
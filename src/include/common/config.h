@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>  // NOLINT
+#include <cstddef>
 #include <cstdint>
 
 namespace bustub {
@@ -36,6 +37,10 @@ static constexpr int BUFFER_POOL_SIZE = 10;
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
 static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int BUSTUB_BATCH_SIZE = 1024;  // number of tuples in an executor batch
+static constexpr size_t QUERY_MEMORY_BUDGET = 64 << 20;  // bytes an operator may hold in memory before it spills
+static constexpr size_t PARALLEL_SCAN_THREADS = 1;       // worker threads of a sequential scan, 1 for a serial scan
+static constexpr size_t NLJ_BLOCK_SIZE = 1024;           // outer tuples a nested loop join buffers per block
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
@@ -45,6 +45,17 @@ class HashUtil {
     return HashBytes(reinterpret_cast<char *>(both), sizeof(hash_t) * 2);
   }
 
+  /** @return the hash mixed by MurmurHash3's 64-bit finalizer, so that every bit depends on every input bit */
+  static inline auto MixHash(hash_t hash) -> hash_t {
+    auto mixed = static_cast<uint64_t>(hash);
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccdULL;
+    mixed ^= mixed >> 33;
+    mixed *= 0xc4ceb9fe1a85ec53ULL;
+    mixed ^= mixed >> 33;
+    return static_cast<hash_t>(mixed);
+  }
+
   static inline auto SumHashes(hash_t l, hash_t r) -> hash_t {
     return (l % PRIME_FACTOR + r % PRIME_FACTOR) % PRIME_FACTOR;
   }
@@ -77,6 +77,14 @@ class TransactionManager {
     return res;
   }
 
+  /**
+   * Find the pages of a table that hold tuples written by transactions that have begun but not yet finished, so that
+   * their rids stay valid for the commit or the abort. The caller must keep new writes to the table out meanwhile.
+   * @param table the table
+   * @return the ids of the pages
+   */
+  auto GetPagesWithRunningWrites(const TableHeap *table) -> std::unordered_set<page_id_t>;
+
   /** Prevents all transactions from performing operations, used for checkpointing. */
   void BlockAllTransactions();
 
@@ -84,6 +92,9 @@ class TransactionManager {
   void ResumeTransactions();
 
  private:
+  /** Take a transaction that has committed or aborted out of the running transactions. */
+  void FinishRunning(Transaction *txn);
+
   /**
    * Releases all the locks held by the given transaction.
    * @param txn the transaction whose locks should be released
@@ -135,6 +146,10 @@ class TransactionManager {
   }
 
   std::atomic<txn_id_t> next_txn_id_{0};
+  /** The transactions that have begun and have not finished committing or aborting. */
+  std::unordered_set<Transaction *> running_txns_;
+  /** Guards running_txns_; Commit() and Abort() hold it shared while they apply a write set. */
+  std::shared_mutex running_txns_latch_;
   LockManager *lock_manager_ __attribute__((__unused__));
   LogManager *log_manager_ __attribute__((__unused__));
 
@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree.h
+//
+// Identification: src/include/container/art/adaptive_radix_tree.h
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+/**
+ * adaptive_radix_tree.h
+ *
+ * Implementation of an in-memory Adaptive Radix Tree with optimistic lock coupling
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * AdaptiveRadixTree maps binary-comparable byte strings to one or more values.
+ *
+ * Inner nodes come in four sizes (Node4, Node16, Node48 and Node256) and grow as children are added; Node16 is
+ * searched with SSE2 where available. Common key bytes are collapsed into a prefix of up to MAX_PREFIX_LEN bytes
+ * stored in the inner node (path compression), longer shared runs are split over a chain of nodes. Leaves hold the
+ * full key and all values for it and are replaced, never modified, once published.
+ *
+ * Concurrency uses optimistic lock coupling: every inner node carries a version word. Readers never write shared
+ * memory, they re-validate the versions of the nodes they read and restart on a conflict. Writers lock only the nodes
+ * they change (plus the parent when a node gets replaced). Replaced nodes and leaves are retired and freed once no
+ * operation is running.
+ *
+ * Keys must be prefix-free, i.e. no key is a proper prefix of another one; NormalizedKey encodings of one schema are.
+ * Inner nodes are not shrunk on removal.
+ *
+ * @tparam V value type
+ */
+template <typename V>
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree();
+  ~AdaptiveRadixTree();
+
+  DISALLOW_COPY_AND_MOVE(AdaptiveRadixTree);
+
+  /**
+   * @brief Insert a (key, value) pair.
+   * @return false if the exact pair already exists, true otherwise
+   */
+  auto Insert(const uint8_t *key, size_t key_len, const V &value) -> bool;
+
+  /**
+   * @brief Remove a (key, value) pair.
+   * @return false if the pair does not exist, true otherwise
+   */
+  auto Remove(const uint8_t *key, size_t key_len, const V &value) -> bool;
+
+  /**
+   * @brief Append all values stored under the key to `result`.
+   * @return true if the key exists
+   */
+  auto GetValue(const uint8_t *key, size_t key_len, std::vector<V> *result) -> bool;
+
+  static constexpr size_t MAX_PREFIX_LEN = 16;
+
+ private:
+  enum class NodeType : uint8_t { Node4, Node16, Node48, Node256, Leaf };
+
+  struct Node {
+    explicit Node(NodeType type) : type_(type) {}
+    const NodeType type_;
+  };
+
+  struct Leaf : public Node {
+    Leaf(const uint8_t *key, size_t key_len) : Node(NodeType::Leaf), key_(key, key + key_len) {}
+    auto KeyEquals(const uint8_t *key, size_t key_len) const -> bool;
+    const std::vector<uint8_t> key_;
+    std::vector<V> values_;
+  };
+
+  /** Common header of the inner nodes. Bit 0 of the version marks an obsolete node, bit 1 a locked one. */
+  struct InnerNode : public Node {
+    explicit InnerNode(NodeType type) : Node(type) {}
+    std::atomic<uint64_t> version_{0};
+    uint16_t num_children_{0};
+    uint8_t prefix_len_{0};
+    uint8_t prefix_[MAX_PREFIX_LEN]{};
+  };
+
+  struct Node4 : public InnerNode {
+    Node4() : InnerNode(NodeType::Node4) {}
+    uint8_t keys_[4]{};
+    std::atomic<Node *> children_[4]{};
+  };
+
+  struct Node16 : public InnerNode {
+    Node16() : InnerNode(NodeType::Node16) {}
+    uint8_t keys_[16]{};
+    std::atomic<Node *> children_[16]{};
+  };
+
+  /** child_index_ maps a key byte to a slot in children_, EMPTY_INDEX if there is no child. */
+  struct Node48 : public InnerNode {
+    static constexpr uint8_t EMPTY_INDEX = 48;
+    Node48();
+    uint8_t child_index_[256];
+    std::atomic<Node *> children_[48]{};
+  };
+
+  struct Node256 : public InnerNode {
+    Node256() : InnerNode(NodeType::Node256) {}
+    std::atomic<Node *> children_[256]{};
+  };
+
+  /** Counts the running operations and retires nodes for them; see Retire(). */
+  class OperationGuard {
+   public:
+    explicit OperationGuard(AdaptiveRadixTree *tree) : tree_(tree) { tree_->active_ops_++; }
+    ~OperationGuard() { tree_->LeaveOperation(); }
+    DISALLOW_COPY_AND_MOVE(OperationGuard);
+
+   private:
+    AdaptiveRadixTree *tree_;
+  };
+
+  /* Version protocol of optimistic lock coupling. All return false when the operation has to restart. */
+  static auto ReadLockOrRestart(InnerNode *node, uint64_t *version) -> bool;
+  static auto CheckOrRestart(InnerNode *node, uint64_t version) -> bool;
+  static auto UpgradeToWriteLockOrRestart(InnerNode *node, uint64_t version) -> bool;
+  static void WriteUnlock(InnerNode *node);
+  static void WriteUnlockObsolete(InnerNode *node);
+
+  /* Node operations; everything except FindChild requires the node to be write locked. */
+  static auto FindChild(InnerNode *node, uint8_t byte) -> Node *;
+  static auto IsFull(InnerNode *node) -> bool;
+  static void AddChild(InnerNode *node, uint8_t byte, Node *child);
+  static void ReplaceChild(InnerNode *node, uint8_t byte, Node *child);
+  static void RemoveChild(InnerNode *node, uint8_t byte);
+  /** @brief Copy the node into the next larger node type. */
+  static auto Grow(InnerNode *node) -> InnerNode *;
+  /** @brief Build the subtree that separates two leaves whose keys are equal up to `depth`. */
+  static auto MakeBranch(Leaf *old_leaf, Leaf *new_leaf, size_t depth) -> InnerNode *;
+  static void FreeNode(Node *node);
+  static void FreeSubtree(Node *node);
+
+  auto TryInsert(const uint8_t *key, size_t key_len, const V &value) -> std::optional<bool>;
+  auto TryRemove(const uint8_t *key, size_t key_len, const V &value) -> std::optional<bool>;
+  auto TryGetValue(const uint8_t *key, size_t key_len, std::vector<V> *result) -> std::optional<bool>;
+
+  /** @brief Defer freeing an unlinked node until no operation can still be reading it. */
+  void Retire(Node *node);
+  void LeaveOperation();
+
+  /** The root is a Node256 without prefix, so it is never replaced. */
+  Node256 *root_;
+  std::atomic<size_t> active_ops_{0};
+  std::mutex garbage_latch_;
+  std::vector<Node *> garbage_;
+};
+
+}  // namespace bustub
@@ -124,7 +124,7 @@ class DiskExtendibleHashTable {
   /**
    * Fetches the directory page from the buffer pool manager.
    *
-   * @return a pointer to the directory page
+   * @return a pointer to the directory page, or nullptr if the buffer pool has no free frame
    */
   auto FetchDirectoryPage() -> HashTableDirectoryPage *;
 
@@ -132,7 +132,7 @@ class DiskExtendibleHashTable {
    * Fetches the a bucket page from the buffer pool manager using the bucket's page_id.
    *
    * @param bucket_page_id the page_id to fetch
-   * @return a pointer to a bucket page
+   * @return a pointer to a bucket page, or nullptr if the buffer pool has no free frame
    */
   auto FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE *;
 
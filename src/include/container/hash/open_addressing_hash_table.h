@@ -0,0 +1,120 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// open_addressing_hash_table.h
+//
+// Identification: src/include/container/hash/open_addressing_hash_table.h
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+/**
+ * open_addressing_hash_table.h
+ *
+ * Implementation of a concurrent in-memory hash table using linear probing
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/rwlatch.h"
+#include "container/hash/hash_table.h"
+
+namespace bustub {
+
+/**
+ * OpenAddressingHashTable is a concurrent hash table that stores keys and values inline in flat slot arrays.
+ *
+ * The table is split into a fixed number of stripes, chosen by the high bits of the key's hash. Each stripe is an
+ * independent linear-probing table with its own reader-writer latch, so lookups in one stripe never block on writers
+ * of another. A stripe that becomes too full doubles itself under its own latch only; the rest of the table stays
+ * available while it rehashes. Removal uses backward-shift deletion, so no tombstones accumulate.
+ *
+ * @tparam K key type
+ * @tparam V value type
+ */
+template <typename K, typename V>
+class OpenAddressingHashTable : public HashTable<K, V> {
+ public:
+  /**
+   * @brief Create a new OpenAddressingHashTable.
+   * @param capacity: number of entries the table should hold without growing
+   * @param num_stripes: number of independently latched stripes, rounded up to a power of two (at least 2)
+   */
+  explicit OpenAddressingHashTable(size_t capacity = 64, size_t num_stripes = 16);
+
+  /**
+   * @brief Find the value associated with the given key.
+   * @param key The key to be searched.
+   * @param[out] value The value associated with the key.
+   * @return True if the key is found, false otherwise.
+   */
+  auto Find(const K &key, V &value) -> bool override;
+
+  /**
+   * @brief Insert the given key-value pair into the hash table. If the key already exists, the value is updated.
+   * @param key The key to be inserted.
+   * @param value The value to be inserted.
+   */
+  void Insert(const K &key, const V &value) override;
+
+  /**
+   * @brief Given the key, remove the corresponding key-value pair in the hash table.
+   * @param key The key to be deleted.
+   * @return True if the key exists, false otherwise.
+   */
+  auto Remove(const K &key) -> bool override;
+
+  /** @return The number of entries in the table. */
+  auto Size() const -> size_t;
+
+  /** @return The total number of slots over all stripes. */
+  auto GetCapacity() const -> size_t;
+
+ private:
+  /** A slot holds its key and value inline, next to the occupancy flag. */
+  struct Slot {
+    K key_;
+    V value_;
+    bool occupied_{false};
+  };
+
+  /** One independently latched linear-probing table. */
+  struct Stripe {
+    mutable ReaderWriterLatch latch_;
+    std::vector<Slot> slots_;
+    size_t size_{0};
+  };
+
+  /** A stripe grows once it is more than MAX_LOAD_NUM / MAX_LOAD_DEN full. */
+  static constexpr size_t MAX_LOAD_NUM = 7;
+  static constexpr size_t MAX_LOAD_DEN = 10;
+
+  /** @brief Hash the key and mix the bits, so that dense keys such as page ids spread over stripes and slots. */
+  static auto HashOf(const K &key) -> uint64_t;
+
+  /** @brief Pick the stripe from the high bits of the hash. */
+  auto StripeOf(uint64_t hash) -> Stripe &;
+
+  /*******************************************************************
+   * Must hold the stripe's latch before calling the below functions. *
+   *******************************************************************/
+
+  /**
+   * @brief Probe for the key in the slot array.
+   * @return The slot holding the key, or the first free slot of its probe sequence.
+   */
+  static auto Probe(const std::vector<Slot> &slots, const K &key, uint64_t hash) -> size_t;
+
+  /** @brief Double the slot array of a stripe and re-insert every entry. */
+  static void Grow(Stripe *stripe);
+
+  size_t stripe_shift_;
+  std::vector<Stripe> stripes_;
+};
+
+}  // namespace bustub
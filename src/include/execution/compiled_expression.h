@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.h
+//
+// Identification: src/include/execution/compiled_expression.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * CompiledExpression is an expression tree flattened into a straight-line program for a small register machine.
+ *
+ * Every node of the tree writes one register. Registers are untyped 8-byte slots plus a NULL flag; the opcodes are
+ * typed instead, so the interpreter never looks at a TypeId at run time: all integer types are widened to int64 on
+ * load and compared as such, DECIMAL lives in double registers, and BOOLEAN results are 0 or 1. Columns are read
+ * straight out of the tuple data at the byte offset resolved at compile time, and the common `column op constant`
+ * comparison on an INTEGER column is fused into one instruction with the constant as an immediate.
+ *
+ * Only fixed-length columns, constants, comparisons, integer arithmetic and AND/OR compile. Compile() returns nullptr
+ * for anything else (e.g. VARCHAR operands), and callers then fall back to AbstractExpression::Evaluate().
+ */
+class CompiledExpression {
+ public:
+  /** The largest number of registers a program may use; deeper trees are not compiled. */
+  static constexpr size_t MAX_REGISTERS = 64;
+
+  /** @return The program for evaluating `expr` on tuples of `schema` as Evaluate() does, or nullptr */
+  static auto Compile(const AbstractExpression &expr, const Schema &schema) -> std::unique_ptr<CompiledExpression>;
+
+  /** @return The program for evaluating `expr` on pairs of tuples as EvaluateJoin() does, or nullptr */
+  static auto CompileJoin(const AbstractExpression &expr, const Schema &left_schema, const Schema &right_schema)
+      -> std::unique_ptr<CompiledExpression>;
+
+  /** @return The value of the expression for the tuple */
+  auto Evaluate(const Tuple *tuple) const -> Value { return EvaluateJoin(tuple, nullptr); }
+
+  /** @return The value of the expression for a pair of tuples */
+  auto EvaluateJoin(const Tuple *left_tuple, const Tuple *right_tuple) const -> Value;
+
+  /** @return true if the boolean expression is true (neither false nor NULL), without materializing a Value */
+  auto EvaluatePredicate(const Tuple *left_tuple, const Tuple *right_tuple = nullptr) const -> bool;
+
+  /** @return The number of instructions in the program */
+  auto Size() const -> size_t { return program_.size(); }
+
+ private:
+  enum class OpCode : uint8_t {
+    // dst <- the column at `offset_` of the left (`side_` 0) or right tuple
+    LoadTinyInt,
+    LoadSmallInt,
+    LoadInteger,
+    LoadBigInt,
+    LoadDecimal,
+    LoadBoolean,
+    // dst <- the immediate, or NULL
+    LoadIntImm,
+    LoadDecimalImm,
+    LoadNull,
+    // dst <- lhs as a double
+    IntToDecimal,
+    // dst <- lhs op rhs
+    EqInt,
+    NeInt,
+    LtInt,
+    LeInt,
+    GtInt,
+    GeInt,
+    EqDecimal,
+    NeDecimal,
+    LtDecimal,
+    LeDecimal,
+    GtDecimal,
+    GeDecimal,
+    // dst <- INTEGER column op immediate
+    EqIntegerImm,
+    NeIntegerImm,
+    LtIntegerImm,
+    LeIntegerImm,
+    GtIntegerImm,
+    GeIntegerImm,
+    // dst <- lhs op rhs as INTEGER, wrapping around
+    AddInteger,
+    SubInteger,
+    // dst <- lhs op rhs in three-valued logic
+    And,
+    Or,
+  };
+
+  struct Register {
+    union {
+      int64_t int_;
+      double decimal_;
+    };
+    bool null_;
+  };
+
+  struct Instruction {
+    OpCode op_;
+    uint8_t side_{0};
+    uint16_t dst_{0};
+    uint16_t lhs_{0};
+    uint16_t rhs_{0};
+    uint32_t offset_{0};
+    union {
+      int64_t int_;
+      double decimal_;
+    } imm_{0};
+  };
+
+  /** The register of a compiled subtree and whether it holds a double. */
+  struct Operand {
+    uint16_t reg_;
+    bool decimal_;
+  };
+
+  class Compiler;
+
+  /** @brief Run the program and return the result register. */
+  auto Run(const Tuple *left_tuple, const Tuple *right_tuple, std::array<Register, MAX_REGISTERS> *regs) const
+      -> const Register &;
+
+  std::vector<Instruction> program_;
+  uint16_t result_{0};
+  TypeId result_type_{TypeId::INVALID};
+};
+
+}  // namespace bustub
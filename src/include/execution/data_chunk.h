@@ -0,0 +1,166 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// data_chunk.h
+//
+// Identification: src/include/execution/data_chunk.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/tuple_batch.h"
+#include "type/limits.h"
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** Indexes of the rows of a chunk that are still alive, in ascending order. */
+using SelectionVector = std::vector<uint32_t>;
+
+/**
+ * Call `f` with a value of the C++ type that stores `type` in a ColumnVector.
+ * @return false if the type has no fixed-length representation, in which case `f` is not called
+ */
+template <typename F>
+auto DispatchFixedType(TypeId type, F &&f) -> bool {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      f(int8_t{});
+      return true;
+    case TypeId::SMALLINT:
+      f(int16_t{});
+      return true;
+    case TypeId::INTEGER:
+      f(int32_t{});
+      return true;
+    case TypeId::BIGINT:
+      f(int64_t{});
+      return true;
+    case TypeId::DECIMAL:
+      f(double{});
+      return true;
+    case TypeId::TIMESTAMP:
+      f(uint64_t{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** @return The in-tuple representation of NULL for a storage type of `type`. */
+template <typename T>
+constexpr auto NullSentinel(TypeId type) -> T {
+  if constexpr (std::is_same_v<T, int8_t>) {
+    return type == TypeId::BOOLEAN ? BUSTUB_BOOLEAN_NULL : BUSTUB_INT8_NULL;
+  } else if constexpr (std::is_same_v<T, int16_t>) {
+    return BUSTUB_INT16_NULL;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return BUSTUB_INT32_NULL;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return BUSTUB_INT64_NULL;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return BUSTUB_DECIMAL_NULL;
+  } else {
+    return BUSTUB_TIMESTAMP_NULL;
+  }
+}
+
+/**
+ * ColumnVector holds one fixed-length column of a chunk: a dense value array indexed by row plus a null bitmap.
+ * Only the rows of the chunk's selection vector carry meaningful data.
+ */
+class ColumnVector {
+ public:
+  /** @return true if values of the type can be stored in a ColumnVector */
+  static auto IsVectorizable(TypeId type) -> bool {
+    return DispatchFixedType(type, [](auto) {});
+  }
+
+  /** @brief Make room for `size` rows of `type` with no NULLs; existing storage is reused. */
+  void Initialize(TypeId type, size_t size) {
+    type_ = type;
+    size_ = size;
+    data_.resize(size);
+    nulls_.assign((size + 63) / 64, 0);
+  }
+
+  auto GetType() const -> TypeId { return type_; }
+
+  auto Size() const -> size_t { return size_; }
+
+  /** Every row has 8 bytes of storage, which fits each fixed-length type. */
+  template <typename T>
+  auto GetData() -> T * {
+    return reinterpret_cast<T *>(data_.data());
+  }
+
+  template <typename T>
+  auto GetData() const -> const T * {
+    return reinterpret_cast<const T *>(data_.data());
+  }
+
+  auto IsNull(size_t idx) const -> bool { return ((nulls_[idx / 64] >> (idx % 64)) & 1) != 0; }
+
+  void SetNull(size_t idx) { nulls_[idx / 64] |= static_cast<uint64_t>(1) << (idx % 64); }
+
+  /** @brief Mark every row NULL that is NULL in `other`. */
+  void MergeNulls(const ColumnVector &other) {
+    for (size_t i = 0; i < nulls_.size(); i++) {
+      nulls_[i] |= other.nulls_[i];
+    }
+  }
+
+  /** @return The row as a Value */
+  auto GetValue(size_t idx) const -> Value;
+
+ private:
+  TypeId type_{TypeId::INVALID};
+  size_t size_{0};
+  std::vector<uint64_t> data_;
+  std::vector<uint64_t> nulls_;
+};
+
+/**
+ * DataChunk is a columnar view of a TupleBatch. Columns are transposed from the tuples the first time an expression
+ * asks for them, and a selection vector tracks which rows survive, so filtering narrows the selection instead of
+ * moving rows around.
+ */
+class DataChunk {
+ public:
+  /** @brief Point the chunk at a batch laid out in `schema`; all rows are selected and no column is loaded. */
+  void Reset(const TupleBatch *batch, const Schema *schema);
+
+  /** @return The number of rows in the underlying batch, selected or not */
+  auto Size() const -> size_t { return batch_->Size(); }
+
+  auto GetSelection() const -> const SelectionVector & { return sel_; }
+
+  /**
+   * @brief Get a column as a vector, loading the selected rows of it on first use.
+   * @return The column, or nullptr if its type has no vector representation
+   */
+  auto GetColumn(uint32_t col_idx) const -> const ColumnVector *;
+
+  /** @brief Keep only the selected rows where the boolean `predicate` is true (not false, not NULL). */
+  void Select(const ColumnVector &predicate);
+
+ private:
+  const TupleBatch *batch_{nullptr};
+  const Schema *schema_{nullptr};
+  SelectionVector sel_;
+  mutable std::vector<ColumnVector> columns_;
+  mutable std::vector<bool> loaded_;
+};
+
+}  // namespace bustub
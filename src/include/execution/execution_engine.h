@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -21,7 +22,9 @@
 #include "execution/executor_context.h"
 #include "execution/executor_factory.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 
 namespace bustub {
 
@@ -85,11 +88,18 @@ class ExecutionEngine {
    */
   static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
                            std::vector<Tuple> *result_set) {
-    RID rid{};
-    Tuple tuple{};
-    while (executor->Next(&tuple, &rid)) {
+    TupleBatch batch;
+    while (executor->NextBatch(&batch)) {
       if (result_set != nullptr) {
-        result_set->push_back(tuple);
+        for (size_t i = 0; i < batch.Size(); i++) {
+          Tuple &tuple = batch.GetTuple(i);
+          // A tuple in the query arena must not outlive the executor context, so the result set gets its own copy.
+          if (tuple.IsAllocated()) {
+            result_set->push_back(std::move(tuple));
+          } else {
+            result_set->push_back(TupleView(tuple.GetRid(), tuple.GetData(), tuple.GetLength()).Materialize());
+          }
+        }
       }
     }
   }
@@ -12,15 +12,25 @@
 
 #pragma once
 
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/arena.h"
 #include "concurrency/transaction.h"
+#include "execution/plans/abstract_plan.h"
 #include "storage/page/tmp_tuple_page.h"
+#include "storage/table/morsel_dispenser.h"
 
 namespace bustub {
+
+class RuntimeFilter;
+class ScanThreshold;
+
 /**
  * ExecutorContext stores all the context necessary to run an executor.
  */
@@ -33,10 +43,19 @@ class ExecutorContext {
    * @param bpm The buffer pool manager that the executor uses
    * @param txn_mgr The transaction manager that the executor uses
    * @param lock_mgr The lock manager that the executor uses
+   * @param memory_budget The number of bytes each operator may keep in memory before it spills to temp pages
+   * @param join_block_size The number of outer tuples a nested loop join buffers per block
    */
   ExecutorContext(Transaction *transaction, Catalog *catalog, BufferPoolManager *bpm, TransactionManager *txn_mgr,
-                  LockManager *lock_mgr)
-      : transaction_(transaction), catalog_{catalog}, bpm_{bpm}, txn_mgr_(txn_mgr), lock_mgr_(lock_mgr) {}
+                  LockManager *lock_mgr, size_t memory_budget = QUERY_MEMORY_BUDGET,
+                  size_t join_block_size = NLJ_BLOCK_SIZE)
+      : transaction_(transaction),
+        catalog_{catalog},
+        bpm_{bpm},
+        txn_mgr_(txn_mgr),
+        lock_mgr_(lock_mgr),
+        memory_budget_(memory_budget),
+        join_block_size_(join_block_size) {}
 
   ~ExecutorContext() = default;
 
@@ -60,6 +79,73 @@ class ExecutorContext {
   /** @return the transaction manager */
   auto GetTransactionManager() -> TransactionManager * { return txn_mgr_; }
 
+  /** @return the number of bytes an operator may keep in memory before it spills */
+  auto GetMemoryBudget() const -> size_t { return memory_budget_; }
+
+  /** @return the number of outer tuples a nested loop join buffers per block */
+  auto GetJoinBlockSize() const -> size_t { return join_block_size_; }
+
+  /**
+   * @return the arena of the query. Executors allocate the state they keep until the query ends from it, e.g. the
+   * tuples of a hash join build side, instead of allocating every tuple on its own.
+   */
+  auto GetArena() -> Arena * { return &arena_; }
+
+  /**
+   * @brief Make the sequential scans of `plan` claim their pages from `dispenser` instead of scanning the whole table.
+   * Must not be called while executors of the query run on other threads.
+   */
+  void SetMorselDispenser(const AbstractPlanNode *plan, MorselDispenser *dispenser) {
+    morsel_dispensers_[plan] = dispenser;
+  }
+
+  /** @return the dispenser that the scans of `plan` claim their pages from, nullptr if the scan is not parallel */
+  auto GetMorselDispenser(const AbstractPlanNode *plan) const -> MorselDispenser * {
+    auto it = morsel_dispensers_.find(plan);
+    return it == morsel_dispensers_.end() ? nullptr : it->second;
+  }
+
+  /** @brief Make the sequential scan of `plan` drop the tuples that do not pass `threshold`. */
+  void SetScanThreshold(const AbstractPlanNode *plan, ScanThreshold *threshold) { scan_thresholds_[plan] = threshold; }
+
+  /** @return the threshold that the scan of `plan` checks its tuples against, nullptr if there is none */
+  auto GetScanThreshold(const AbstractPlanNode *plan) const -> ScanThreshold * {
+    auto it = scan_thresholds_.find(plan);
+    return it == scan_thresholds_.end() ? nullptr : it->second;
+  }
+
+  /** @brief Publish the runtime filter `id` of the plan, built by a hash join, to the scans that check it. */
+  void SetRuntimeFilter(size_t id, RuntimeFilter *filter) { runtime_filters_[id] = filter; }
+
+  /** @return the runtime filter `id` of the plan, nullptr if no hash join publishes it */
+  auto GetRuntimeFilter(size_t id) const -> RuntimeFilter * {
+    auto it = runtime_filters_.find(id);
+    return it == runtime_filters_.end() ? nullptr : it->second;
+  }
+
+  /**
+   * @brief Add `delta` to a runtime counter of `plan`, e.g. the number of tuples its executor spilled. The counters
+   * are shown by EXPLAIN ANALYZE. Safe to call from parallel workers.
+   */
+  void AddStat(const AbstractPlanNode *plan, const std::string &name, size_t delta) {
+    std::scoped_lock lock(stats_latch_);
+    auto &stats = stats_[plan];
+    for (auto &[stat_name, value] : stats) {
+      if (stat_name == name) {
+        value += delta;
+        return;
+      }
+    }
+    stats.emplace_back(name, delta);
+  }
+
+  /** @return the runtime counters of `plan` in the order they were first recorded */
+  auto GetStats(const AbstractPlanNode *plan) const -> std::vector<std::pair<std::string, size_t>> {
+    std::scoped_lock lock(stats_latch_);
+    auto it = stats_.find(plan);
+    return it == stats_.end() ? std::vector<std::pair<std::string, size_t>>{} : it->second;
+  }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +157,21 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** The memory budget of each operator of the query */
+  size_t memory_budget_;
+  /** The block size of nested loop joins */
+  size_t join_block_size_;
+  /** The morsel dispensers of the scans run by parallel workers */
+  std::unordered_map<const AbstractPlanNode *, MorselDispenser *> morsel_dispensers_;
+  /** The thresholds that TopNs pass down to the sequential scans below them */
+  std::unordered_map<const AbstractPlanNode *, ScanThreshold *> scan_thresholds_;
+  /** The runtime filters that hash joins publish to the scans on their probe sides, by the id in the plan */
+  std::unordered_map<size_t, RuntimeFilter *> runtime_filters_;
+  /** The runtime counters of the executors, per plan node */
+  std::unordered_map<const AbstractPlanNode *, std::vector<std::pair<std::string, size_t>>> stats_;
+  mutable std::mutex stats_latch_;
+  /** The memory that lives as long as the query */
+  Arena arena_;
 };
 
 }  // namespace bustub
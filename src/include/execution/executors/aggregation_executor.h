@@ -13,6 +13,8 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -21,8 +23,10 @@
 #include "container/hash/hash_function.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
@@ -33,6 +37,9 @@ namespace bustub {
  */
 class SimpleAggregationHashTable {
  public:
+  /** The map from the keys to the values of the groups, allocating its entries from a memory resource. */
+  using Map = std::pmr::unordered_map<AggregateKey, AggregateValue>;
+
   /**
    * Construct a new SimpleAggregationHashTable instance.
    * @param agg_exprs the aggregation expressions
@@ -40,10 +47,12 @@ class SimpleAggregationHashTable {
    */
   SimpleAggregationHashTable(const std::vector<AbstractExpressionRef> &agg_exprs,
                              const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
+      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {
+    ht_.emplace(std::pmr::get_default_resource());
+  }
 
   /** @return The initial aggregrate value for this aggregation executor */
-  auto GenerateInitialAggregateValue() -> AggregateValue {
+  auto GenerateInitialAggregateValue() const -> AggregateValue {
     std::vector<Value> values{};
     for (const auto &agg_type : agg_types_) {
       switch (agg_type) {
@@ -70,7 +79,7 @@ class SimpleAggregationHashTable {
    * @param[out] result The output aggregate value
    * @param input The input value
    */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
+  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) const {
     for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
       auto &result_value = result->aggregates_[i];
       auto &input_value = input.aggregates_[i];
@@ -117,6 +126,38 @@ class SimpleAggregationHashTable {
     }
   }
 
+  /**
+   * Merges a partial aggregation result, e.g. one computed by another thread, into the aggregation result.
+   * @param[out] result The output aggregate value
+   * @param partial The partial aggregate value of the same group
+   */
+  void MergeAggregateValues(AggregateValue *result, const AggregateValue &partial) const {
+    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      auto &result_value = result->aggregates_[i];
+      const auto &partial_value = partial.aggregates_[i];
+      if (partial_value.IsNull()) {
+        continue;
+      }
+      if (result_value.IsNull()) {
+        result_value = partial_value;
+        continue;
+      }
+      switch (agg_types_[i]) {
+        case AggregationType::CountStarAggregate:
+        case AggregationType::CountAggregate:
+        case AggregationType::SumAggregate:
+          result_value = result_value.Add(partial_value);
+          break;
+        case AggregationType::MinAggregate:
+          result_value = result_value.Min(partial_value);
+          break;
+        case AggregationType::MaxAggregate:
+          result_value = result_value.Max(partial_value);
+          break;
+      }
+    }
+  }
+
   /**
    * Inserts a value into the hash table and then combines it with the current aggregation.
    * @param agg_key the key to be inserted
@@ -124,14 +165,33 @@ class SimpleAggregationHashTable {
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
     is_checked_ = true;
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+    if (ht_->count(agg_key) == 0) {
+      ht_->insert({agg_key, GenerateInitialAggregateValue()});
+    }
+    CombineAggregateValues(&(*ht_)[agg_key], agg_val);
+  }
+
+  /**
+   * Combines a value into the aggregation of its key if the key is in the hash table already.
+   * @param agg_key the key of the group
+   * @param agg_val the value to be combined
+   * @return `false` if the key is not in the hash table, which is left unchanged then
+   */
+  auto CombineExisting(const AggregateKey &agg_key, const AggregateValue &agg_val) -> bool {
+    auto it = ht_->find(agg_key);
+    if (it == ht_->end()) {
+      return false;
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+    is_checked_ = true;
+    CombineAggregateValues(&it->second, agg_val);
+    return true;
   }
 
+  /** @return The number of groups in the hash table */
+  auto Size() const -> size_t { return ht_->size(); }
+
   auto CheckCountStart(AggregateValue *value) -> bool {
-    if (is_checked_ || !ht_.empty()) {
+    if (is_checked_ || !ht_->empty()) {
       return false;
     }
     is_checked_ = true;
@@ -144,14 +204,15 @@ class SimpleAggregationHashTable {
   bool is_checked_ = false;
   /**
    * Clear the hash table
+   * @param resource the memory resource that the entries of the table are allocated from from now on
    */
-  void Clear() { ht_.clear(); }
+  void Clear(std::pmr::memory_resource *resource) { ht_.emplace(resource); }
 
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
     /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    explicit Iterator(Map::const_iterator iter) : iter_{iter} {}
 
     /** @return The key of the iterator */
     auto Key() -> const AggregateKey & { return iter_->first; }
@@ -173,27 +234,71 @@ class SimpleAggregationHashTable {
 
    private:
     /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    Map::const_iterator iter_;
   };
 
   /** @return Iterator to the start of the hash table */
-  auto Begin() -> Iterator { return Iterator{ht_.cbegin()}; }
+  auto Begin() -> Iterator { return Iterator{ht_->cbegin()}; }
 
   /** @return Iterator to the end of the hash table */
-  auto End() -> Iterator { return Iterator{ht_.cend()}; }
+  auto End() -> Iterator { return Iterator{ht_->cend()}; }
 
  private:
   /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  std::optional<Map> ht_;
   /** The aggregate expressions that we have */
   const std::vector<AbstractExpressionRef> &agg_exprs_;
   /** The types of aggregations that we have */
   const std::vector<AggregationType> &agg_types_;
 };
 
+/**
+ * FlatAggregationTable is a single-threaded hash table of groups used by the parallel aggregation. Groups are stored
+ * densely in insertion order, and an open-addressing array of group indexes finds them by the mixed hash of their key.
+ */
+class FlatAggregationTable {
+ public:
+  /** A group together with the hash of its key. */
+  struct Group {
+    hash_t hash_;
+    AggregateKey key_;
+    AggregateValue value_;
+  };
+
+  /**
+   * @brief Find the group of a key, inserting it with the initial value if it is new.
+   * @return The aggregate value of the group
+   */
+  auto FindOrInsert(hash_t hash, AggregateKey &&key, const AggregateValue &initial) -> AggregateValue *;
+
+  /** @return The groups in insertion order */
+  auto GetGroups() -> std::vector<Group> & { return groups_; }
+
+  auto Size() const -> size_t { return groups_.size(); }
+
+ private:
+  /** @brief Double the index array and re-insert every group. */
+  void Grow();
+
+  std::vector<Group> groups_;
+  /** Group index + 1 per slot, 0 for a free slot. */
+  std::vector<uint32_t> slots_;
+  hash_t mask_{0};
+};
+
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
  * over the tuples produced by a child executor.
+ *
+ * If the child is a parallel scan, the aggregation runs on its workers: each worker pre-aggregates the batches it
+ * produces into thread-local tables, one per hash partition, so that workers never share a table. The partitions are
+ * then merged in parallel, each by one thread, which needs no latching either since the partitions are disjoint.
+ *
+ * Otherwise the groups are kept in a SimpleAggregationHashTable until they exceed the memory budget of the query. From
+ * then on, input tuples of groups that are in the table still update it, while those of new groups are spilled to
+ * temp pages, split into SPILL_FANOUT partitions on the high bits of the key hash. Once the groups in memory have been
+ * emitted, each partition is aggregated on its own the same way, so one that is still too large is split again on the
+ * next bits, up to MAX_SPILL_DEPTH levels. A group thus never has tuples both in memory and in a partition.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -217,13 +322,71 @@ class AggregationExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the aggregation.
+   * @param[out] batch The batch to fill
+   * @return `true` if the batch holds at least one tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the aggregation */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
   /** Do not use or remove this function, otherwise you will get zero points. */
   auto GetChildExecutor() const -> const AbstractExecutor *;
 
+  /** The number of hash bits that pick the partition of a group in a parallel aggregation. */
+  static constexpr size_t PARTITION_BITS = 6;
+  static constexpr size_t NUM_PARTITIONS = static_cast<size_t>(1) << PARTITION_BITS;
+  /** The number of hash bits that split spilled input, i.e. it is split into 2^SPILL_BITS partitions. */
+  static constexpr size_t SPILL_BITS = 4;
+  static constexpr size_t SPILL_FANOUT = static_cast<size_t>(1) << SPILL_BITS;
+  /** The number of times the input is split at most when spilling. */
+  static constexpr size_t MAX_SPILL_DEPTH = 3;
+
  private:
+  /** The spilled input tuples of one partition of the groups. */
+  struct SpillPartition {
+    std::unique_ptr<TmpTupleFile> file_;
+    /** The number of times the input was split to produce this partition. */
+    size_t depth_;
+  };
+
+  /** @return The mixed hash of an aggregate key */
+  static auto HashKey(const AggregateKey &key) -> hash_t { return HashUtil::MixHash(std::hash<AggregateKey>{}(key)); }
+
+  /** @return The spill partition of a hash at the given depth, picked by the bits below those of the lower depths */
+  static auto SpillPartitionOf(hash_t hash, size_t depth) -> size_t {
+    return (hash >> (sizeof(hash_t) * 8 - SPILL_BITS * (depth + 1))) & (SPILL_FANOUT - 1);
+  }
+
+  /** @return The estimated memory a group takes in the hash table */
+  static auto GroupBytes(const AggregateKey &key, const AggregateValue &value) -> size_t {
+    return sizeof(AggregateKey) + sizeof(AggregateValue) + sizeof(hash_t) * 4 +
+           sizeof(Value) * (key.group_bys_.size() + value.aggregates_.size());
+  }
+
+  /**
+   * @brief Aggregate an input tuple of the given spill depth into the hash table, or append it to its partition in
+   * `spill` if its group is not in the table and the table is full. `spill` is created when the table fills up.
+   */
+  void Aggregate(const Tuple &tuple, size_t depth, std::vector<SpillPartition> *spill);
+
+  /** @brief Finish writing the partitions that were spilled to and queue the non-empty ones. */
+  void FinishSpill(std::vector<SpillPartition> *spill);
+
+  /** @brief Aggregate the next pending spilled partition into the hash table. @return false if there is none */
+  auto NextSpillPartition() -> bool;
+
+  /** @brief Aggregate the output of a parallel scan on its workers and merge the partitions in parallel. */
+  void AggregateParallel(GatherExecutor *gather);
+
+  /** @brief Get the next group of the result. @return false if there are no more groups */
+  auto NextGroup(const AggregateKey **key, const AggregateValue **value) -> bool;
+
+  /** @return The output tuple of a group */
+  auto MakeOutputTuple(const AggregateKey &key, const AggregateValue &value) const -> Tuple;
+
   /** @return The tuple as an AggregateKey */
   auto MakeAggregateKey(const Tuple *tuple) -> AggregateKey {
     std::vector<Value> keys;
@@ -251,5 +414,18 @@ class AggregationExecutor : public AbstractExecutor {
   SimpleAggregationHashTable aht_;
   /** Simple aggregation hash table iterator */
   SimpleAggregationHashTable::Iterator aht_iterator_;
+
+  /** The estimated memory taken by the groups in the hash table. */
+  size_t table_bytes_{0};
+  /** Whether Init() ran before; only the table of the first run lives in the query arena. */
+  bool initialized_{false};
+  /** The spilled partitions that still have to be aggregated. */
+  std::vector<SpillPartition> pending_;
+
+  /** Whether the groups were computed in parallel, and the merged partitions if so. */
+  bool parallel_{false};
+  std::vector<FlatAggregationTable> partitions_;
+  size_t partition_idx_{0};
+  size_t group_idx_{0};
 };
 }  // namespace bustub
@@ -15,6 +15,8 @@
 #include <memory>
 #include <vector>
 
+#include "execution/compiled_expression.h"
+#include "execution/data_chunk.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/filter_plan.h"
@@ -48,6 +50,13 @@ class FilterExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the filter.
+   * @param[out] batch The batch to fill
+   * @return `true` if the batch holds at least one tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -57,5 +66,13 @@ class FilterExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The predicate compiled to bytecode, or nullptr if it does not compile */
+  std::unique_ptr<CompiledExpression> program_;
+
+  /** Columnar view of the batch being filtered */
+  DataChunk chunk_;
+  /** Result of the predicate over `chunk_` */
+  ColumnVector predicate_;
 };
 }  // namespace bustub
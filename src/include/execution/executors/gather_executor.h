@@ -0,0 +1,127 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.h
+//
+// Identification: src/include/execution/executors/gather_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/gather_plan.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/morsel_dispenser.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * GatherExecutor executes a morsel-driven parallel scan.
+ *
+ * Init() builds one executor tree for the child plan per worker and registers a MorselDispenser for the scan at its
+ * bottom, so that the scans of all workers split the pages of the table between them. On the first call to Next() or
+ * NextBatch(), each worker starts on its own thread and pushes its batches into a bounded queue, which the executor
+ * drains in whatever order the batches arrive. A full queue blocks the workers until the parent catches up.
+ *
+ * A parent that can consume batches in parallel, such as an aggregation, calls RunWorkers() instead and gets the
+ * batches handed to it on the worker threads, which skips the queue. Either way, an exception thrown by a worker is
+ * rethrown to the parent.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new GatherExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The gather plan to be executed
+   */
+  GatherExecutor(ExecutorContext *exec_ctx, const GatherPlanNode *plan);
+
+  /** Stop and join the workers. */
+  ~GatherExecutor() override;
+
+  /** Initialize the workers */
+  void Init() override;
+
+  /**
+   * Yield the next tuple produced by any of the workers.
+   * @param[out] tuple The next tuple
+   * @param[out] rid The RID of the next tuple
+   * @return `true` if a tuple was produced, `false` if all workers are done
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** Yield the next batch produced by any of the workers. */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /**
+   * @brief Run the workers to the end, each on its own thread, passing every batch a worker produces to `sink` on the
+   * thread of that worker. Returns once all workers are done. Must be called right after Init() instead of Next().
+   * @param sink called as `sink(worker_idx, batch)`, concurrently for different workers
+   */
+  void RunWorkers(const std::function<void(size_t, TupleBatch *)> &sink);
+
+  /** @return The number of workers, which is also the largest worker index passed to a sink plus one */
+  auto GetNumWorkers() const -> size_t { return plan_->GetNumWorkers(); }
+
+  /** @return The output schema of the gather */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+  /** The number of batches per worker that the queue holds at most. */
+  static constexpr size_t QUEUED_BATCHES_PER_WORKER = 2;
+
+ private:
+  /** @brief Start a thread for each worker that pushes its batches into the queue. */
+  void StartWorkers();
+
+  /** @brief Run the executor tree of a worker to the end, pushing its batches into the queue. */
+  void RunWorker(AbstractExecutor *worker);
+
+  /** @brief Wait for the next batch of any worker and swap it into `batch`. @return false if all workers are done */
+  auto PopBatch(TupleBatch *batch) -> bool;
+
+  /** @brief Tell the workers to stop and wait for their threads to exit. */
+  void StopWorkers();
+
+  /** The gather plan node to be executed */
+  const GatherPlanNode *plan_;
+
+  std::unique_ptr<MorselDispenser> dispenser_;
+  std::vector<std::unique_ptr<AbstractExecutor>> workers_;
+  std::vector<std::thread> threads_;
+
+  /** Protects everything below up to the current batch. */
+  std::mutex latch_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<TupleBatch> queue_;
+  /** Drained batches handed back to the workers, so that their slots are reused. */
+  std::vector<TupleBatch> free_batches_;
+  /** The number of workers that have not finished yet. */
+  size_t running_{0};
+  bool started_{false};
+  /** Set to make the workers stop early; also read without the latch by workers that run a sink. */
+  std::atomic<bool> stopped_{false};
+  std::exception_ptr error_;
+
+  /** The batch that Next() emits tuples from. */
+  TupleBatch current_;
+  size_t current_idx_{0};
+};
+
+}  // namespace bustub
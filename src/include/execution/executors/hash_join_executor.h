@@ -14,16 +14,38 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "common/util/hash_util.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/hash_join_plan.h"
+#include "execution/runtime_filter.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes an equi-JOIN on two tables with an in-memory hash table.
+ *
+ * The right child is the build side and the left child probes, so a LEFT join can emit unmatched probe tuples as it
+ * goes. The hash table is flat: a bucket array of chain heads plus a parallel `next` array over the build tuples,
+ * indexed by the mixed HashUtil hash of the join key. When the build side does not fit into one partition of
+ * PARTITION_TUPLES tuples, it is radix partitioned on the low bits of the hash first and each partition gets a hash
+ * table of its own that stays cache resident. Probe tuples are streamed to the table of their partition, so the probe
+ * side is never buffered and the memory of the join is bounded by the build side.
+ *
+ * If the build side exceeds the memory budget of the query, the join turns into a Grace hash join: both inputs are
+ * split on the high bits of the hash into SPILL_FANOUT partitions that are written to temp pages through the buffer
+ * pool, and each pair of partitions is then joined in memory as above. A partition that is still too large is split
+ * again on the next bits, up to MAX_SPILL_DEPTH levels; beyond that (e.g. a single huge key) it is joined in memory
+ * regardless of the budget.
+ *
+ * If the plan asks for a runtime filter, the join reads its build side before it initializes the probe side, and
+ * publishes a RuntimeFilter over the build keys in between, so that the probe side scan drops tuples that cannot
+ * match.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -48,12 +70,126 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Yield the next batch of joined tuples. */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
+  /** The number of build tuples a partition should hold at most. */
+  static constexpr size_t PARTITION_TUPLES = 16384;
+  /** The largest number of hash bits used for partitioning, i.e. at most 2^MAX_RADIX_BITS partitions. */
+  static constexpr size_t MAX_RADIX_BITS = 8;
+  /** The number of hash bits that split a spilled partition, i.e. it is split into 2^SPILL_BITS partitions. */
+  static constexpr size_t SPILL_BITS = 4;
+  static constexpr size_t SPILL_FANOUT = static_cast<size_t>(1) << SPILL_BITS;
+  /** The number of times the inputs are split at most when spilling. */
+  static constexpr size_t MAX_SPILL_DEPTH = 3;
+
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** A tuple together with its join key and the hash of the key. */
+  struct HashedTuple {
+    Tuple tuple_;
+    Value key_;
+    hash_t hash_{0};
+  };
+
+  /** The build tuples whose keys hash into one partition, and the hash table over them. */
+  struct Partition {
+    std::vector<HashedTuple> build_;
+    /** Chain heads per bucket and the chain link of each build tuple, both as index + 1 into build_. */
+    std::vector<uint32_t> heads_;
+    std::vector<uint32_t> next_;
+    hash_t bucket_mask_{0};
+  };
+
+  /** The build and probe tuples of one partition of a spilled join. */
+  struct SpillPartition {
+    std::unique_ptr<TmpTupleFile> build_;
+    std::unique_ptr<TmpTupleFile> probe_;
+    /** The number of times the inputs were split to produce this partition. */
+    size_t depth_;
+  };
+
+  /** @return The memory a build tuple takes in the hash table */
+  static auto EntryBytes(const Tuple &tuple) -> size_t { return sizeof(HashedTuple) + tuple.GetLength(); }
+
+  /** @return The spill partition of a hash at the given depth, picked by the bits below those of the lower depths */
+  static auto SpillPartitionOf(hash_t hash, size_t depth) -> size_t {
+    return (hash >> (sizeof(hash_t) * 8 - SPILL_BITS * (depth + 1))) & (SPILL_FANOUT - 1);
+  }
+
+  /** @return The key of the tuple under the expression and its hash; the hash is meaningless for a NULL key. */
+  static auto HashKey(const AbstractExpression &key_expr, Tuple tuple, const Schema &schema) -> HashedTuple;
+
+  /** @return SPILL_FANOUT empty partitions of the given depth */
+  auto MakeSpillPartitions(size_t depth) -> std::vector<SpillPartition>;
+
+  /** @brief Split a spilled partition that exceeds the memory budget one level further. */
+  void SplitSpillPartition(SpillPartition *partition);
+
+  /** @brief Finish writing the partitions, queue them to be joined in order and record them in the stats. */
+  void QueueSpillPartitions(std::vector<SpillPartition> *partitions);
+
+  /** @brief Load the next pending spilled partition and start joining it. @return false if there is none */
+  auto NextSpillPartition() -> bool;
+
+  /** @brief Set up the in-memory join of the build tuples with the current probe input. */
+  void JoinInMemory(std::vector<HashedTuple> build);
+
+  /** @brief Read the next tuple of the probe input: the left child, or the spilled partition being joined. */
+  auto NextProbeTuple(Tuple *tuple) -> bool;
+
+  /** @brief Build the hash table of the partition over its build tuples. */
+  void BuildTable(Partition *partition) const;
+
+  /** @brief Make the next probe tuple of the in-memory join current. @return false if the probe side is exhausted */
+  auto AdvanceInMemoryProbe() -> bool;
+
+  /** @brief Make the next probe tuple current, moving on to the next spilled partition if needed. */
+  auto AdvanceProbe() -> bool;
+
+  /** @brief Produce the next output tuple. */
+  auto Produce(Tuple *tuple) -> bool;
+
+  /** @brief Concatenate the current probe tuple with a build tuple, or with NULLs if `build` is nullptr. */
+  auto MakeOutput(const Tuple *build) const -> Tuple;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+
+  std::unique_ptr<AbstractExecutor> left_child_;
+  std::unique_ptr<AbstractExecutor> right_child_;
+
+  /** Number of low hash bits that select a partition; 0 if the join is not partitioned. */
+  size_t radix_bits_{0};
+  std::vector<Partition> partitions_;
+  /** The partition of the current probe tuple. */
+  size_t partition_idx_{0};
+
+  /** The filter over the build keys that the probe side scan checks, nullptr if the plan has none. */
+  std::unique_ptr<RuntimeFilter> runtime_filter_;
+
+  /** Whether Init() ran before; only the build side of the first run lives in the query arena. */
+  bool initialized_{false};
+
+  /** Whether the inputs were spilled, and the partitions that still have to be joined if so. */
+  bool spilled_{false};
+  std::vector<SpillPartition> pending_;
+  /** The probe tuples of the spilled partition being joined. */
+  std::unique_ptr<TmpTupleFile> probe_file_;
+
+  /** Probe tuples read from the left child when the join is not spilled. */
+  TupleBatch probe_batch_;
+  size_t probe_batch_idx_{0};
+  bool probe_exhausted_{false};
+
+  /** The probe tuple being joined, the next entry of its bucket chain and whether it has matched so far. */
+  HashedTuple probe_;
+  std::vector<Value> probe_values_;
+  bool has_probe_{false};
+  uint32_t chain_{0};
+  bool matched_{false};
 };
 
 }  // namespace bustub
@@ -47,5 +47,10 @@ class IndexScanExecutor : public AbstractExecutor {
   BPlusTreeIndexForOneIntegerColumn* tree_=nullptr;
   TableHeap *table_=nullptr;
   BPlusTreeIndexIteratorForOneIntegerColumn begin_;
+  /** RIDs matched by a point lookup, and the position of the next one to emit */
+  std::vector<RID> rids_;
+  size_t cursor_{0};
+  /** The number of tuples emitted since Init(), checked against the limit of the plan. */
+  size_t emitted_{0};
 };
 }  // namespace bustub
@@ -24,7 +24,8 @@ namespace bustub {
 
 /**
  * InsertExecutor executes an insert on a table.
- * Inserted values are always pulled from a child executor.
+ * Inserted values are always pulled from a child executor, a batch at a time, and appended to the table and its
+ * indexes in bulk.
  */
 class InsertExecutor : public AbstractExecutor {
  public:
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes an equi-JOIN on two inputs that both arrive in ascending order of their join key.
+ *
+ * Both children are streamed once. The right tuples that share the key of the current left tuple are buffered as a
+ * group, so consecutive left tuples with the same key are joined with the group without reading the right side again;
+ * only one group is ever held in memory. NULL keys never match and may sit anywhere in either input. An INNER join
+ * stops as soon as the right side is exhausted and the current left key is past its last key.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The MergeJoin join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join
+   * @param right_child The child executor that produces tuples for the right side of join
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join.
+   * @param[out] rid The next tuple RID, not used by merge join.
+   * @return `true` if a tuple was produced, `false` if there are no more tuples.
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /** Yield the next batch of joined tuples. */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** @return The output schema for the join */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
+
+ private:
+  /** @brief Make the next left tuple current. @return false if the left side is exhausted */
+  auto AdvanceLeft() -> bool;
+
+  /** @brief Load the next batch of the right side if the current one is used up. @return false at the end */
+  auto FillRight() -> bool;
+
+  /** @brief Skip the right tuples with a smaller or NULL key and buffer those equal to `key` as the group. */
+  void LoadGroup(const Value &key);
+
+  /** @brief Produce the next output tuple. */
+  auto Produce(Tuple *tuple) -> bool;
+
+  /** The MergeJoin plan node to be executed. */
+  const MergeJoinPlanNode *plan_;
+
+  std::unique_ptr<AbstractExecutor> left_child_;
+  std::unique_ptr<AbstractExecutor> right_child_;
+
+  /** A tuple of NULLs in the right schema to pad unmatched tuples of a LEFT join. */
+  Tuple null_right_;
+
+  /** The current batch of left tuples, the left tuple being joined, its key and whether it is in the group. */
+  TupleBatch left_batch_;
+  size_t left_idx_{0};
+  bool left_exhausted_{false};
+  bool has_left_{false};
+  Value left_key_;
+  bool left_matches_{false};
+
+  /** The current batch of right tuples with their keys, and the next right tuple that is not in a group yet. */
+  TupleBatch right_batch_;
+  std::vector<Value> right_keys_;
+  size_t right_idx_{0};
+  bool right_exhausted_{false};
+
+  /** The right tuples whose key equals `group_key_`, and the next one to join the current left tuple with. */
+  std::vector<Tuple> group_;
+  Value group_key_;
+  size_t group_idx_{0};
+
+  /** Set once no further output is possible. */
+  bool done_{false};
+};
+
+}  // namespace bustub
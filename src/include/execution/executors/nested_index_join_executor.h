@@ -22,13 +22,20 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/nested_index_join_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 /**
  * IndexJoinExecutor executes index join operations.
+ *
+ * The outer child is read one block of ExecutorContext::GetJoinBlockSize() tuples at a time. The join keys of a block
+ * are sorted and deduplicated and probed with a single Index::ScanKeys() call, so a B+ tree serves runs of nearby keys
+ * from the same leaf. The matching inner tuples are then fetched from the table in rid order, one page access per run
+ * of rids on a page, and emitted in the order of the outer tuples.
  */
 class NestIndexJoinExecutor : public AbstractExecutor {
  public:
@@ -47,8 +54,40 @@ class NestIndexJoinExecutor : public AbstractExecutor {
 
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Yield the next batch of joined tuples. */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
  private:
+  /** An inner tuple that matches an outer tuple of the current block. */
+  struct Match {
+    uint32_t outer_idx_;
+    RID rid_;
+    Tuple inner_;
+    bool found_;
+  };
+
+  /** @brief Read the next outer block, probe the index with its keys and fetch the matching inner tuples. */
+  auto LoadBlock() -> bool;
+
+  /** @brief Produce the next output tuple. */
+  auto Produce(Tuple *tuple) -> bool;
+
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  IndexInfo *index_info_{nullptr};
+  TableInfo *table_info_{nullptr};
+
+  /** A tuple of NULLs in the inner schema to pad unmatched tuples of a LEFT join. */
+  Tuple null_inner_;
+
+  /** The current outer block and its matches, ordered by outer tuple. */
+  TupleBatch block_;
+  std::vector<Match> matches_;
+  bool child_exhausted_{false};
+  /** The outer tuple being joined, its next match and whether it has matched so far. */
+  size_t outer_idx_{0};
+  size_t match_idx_{0};
+  bool matched_{false};
 };
 }  // namespace bustub
@@ -14,10 +14,13 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/nested_loop_join_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
@@ -25,6 +28,11 @@ namespace bustub {
 
 /**
  * NestedLoopJoinExecutor executes a nested-loop JOIN on two tables.
+ *
+ * The join is a block nested loop join: the right child is materialized once in Init(), and the left child is read
+ * one block of ExecutorContext::GetJoinBlockSize() tuples at a time, each of which is then joined with every right
+ * tuple. Output tuples are produced on demand, so only the right side and one block of the left side are ever held in
+ * memory, and the first tuple does not have to wait for the whole join.
  */
 class NestedLoopJoinExecutor : public AbstractExecutor {
  public:
@@ -50,15 +58,38 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /** Yield the next batch of joined tuples. */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the insert */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
+  /** @brief Produce the next output tuple. */
+  auto Produce(Tuple *tuple) -> bool;
+
+  /** @return true if the join predicate holds for the pair, evaluated by walking the expression tree */
+  auto Matches(const Tuple &left_tuple, const Tuple &right_tuple) const -> bool;
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
 
-  std::unique_ptr<AbstractExecutor> left_exector_,right_executor_;
-  std::deque<Tuple> result_tuples_={};
+  std::unique_ptr<AbstractExecutor> left_exector_, right_executor_;
+
+  /** The join predicate compiled to bytecode, or nullptr if it does not compile. */
+  std::unique_ptr<CompiledExpression> program_;
+
+  /** The materialized right side, and a tuple of NULLs in its schema to pad unmatched tuples of a LEFT join. */
+  std::vector<Tuple> right_tuples_;
+  Tuple null_right_;
+
+  /** The current block of left tuples, the left tuple being joined and whether it has matched so far. */
+  TupleBatch left_block_;
+  size_t left_idx_{0};
+  bool matched_{false};
+  bool left_exhausted_{false};
+  /** The next right tuple to join the current left tuple with. */
+  size_t right_idx_{0};
 };
 
 }  // namespace bustub
@@ -15,6 +15,8 @@
 #include <memory>
 #include <vector>
 
+#include "execution/compiled_expression.h"
+#include "execution/data_chunk.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/projection_plan.h"
@@ -47,6 +49,13 @@ class ProjectionExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the projection.
+   * @param[out] batch The batch to fill
+   * @return `true` if the batch holds at least one tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the projection plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -56,5 +65,14 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The batch pulled from the child by NextBatch() */
+  TupleBatch child_batch_;
+  /** Columnar view of `child_batch_` */
+  DataChunk chunk_;
+  /** The value of every expression over `chunk_`, and whether it could be computed column-wise */
+  std::vector<ColumnVector> columns_;
+  std::vector<bool> vectorized_;
+  /** Every expression compiled to bytecode, or nullptr where it does not compile */
+  std::vector<std::unique_ptr<CompiledExpression>> programs_;
 };
 }  // namespace bustub
@@ -17,12 +17,28 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/runtime_filter.h"
+#include "execution/scan_predicate.h"
+#include "storage/table/morsel_dispenser.h"
+#include "storage/table/table_page_guard.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
+ *
+ * The table is read a page at a time, in place: the executor keeps the current page pinned, evaluates the filter
+ * predicate of the plan on TupleViews into it, and copies out only the tuples it emits, straight into the tuple or
+ * batch slot of the caller. The page is latched only while it is read, not between calls, so that the parent may
+ * modify the table being scanned.
+ *
+ * When the executor context holds a MorselDispenser for the plan, the executor is one worker of a parallel scan: it
+ * reads only the pages it claims from the dispenser, a morsel at a time, and leaves the rest to the other workers.
+ *
+ * The scan stops after the `limit_` of the plan, if it has one, and drops the tuples that do not pass the
+ * ScanThreshold a TopN above it registered for the plan, if there is one. If the plan names a runtime filter, the scan
+ * also drops the tuples whose key column is certainly not among the build keys of the hash join that publishes it.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -44,6 +60,13 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the scan.
+   * @param[out] batch The batch to fill
+   * @return `true` if the batch holds at least one tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -53,7 +76,47 @@ class SeqScanExecutor : public AbstractExecutor {
 
   TableHeap *table_heap_=nullptr;
   TableInfo *table_info_=nullptr;
-  TableIterator table_iterator_;
 
+  /** The filter predicate of the plan, split into page kernels and a residual. */
+  ScanPredicate predicate_;
+  /** The runtime filter of the hash join above, nullptr if there is none, and how to read the key it checks. */
+  const RuntimeFilter *runtime_filter_{nullptr};
+  IntegerColumnReader runtime_filter_read_{nullptr};
+  uint32_t runtime_filter_offset_{0};
+  /** The threshold of the TopN above, nullptr if there is none. */
+  ScanThreshold *threshold_{nullptr};
+  /** The number of tuples emitted since Init(). */
+  size_t emitted_{0};
+  /** The next page to read if this is a serial scan. */
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+
+  /** The dispenser to claim pages from if this is a worker of a parallel scan, nullptr otherwise. */
+  MorselDispenser *dispenser_{nullptr};
+  /** The pages of the claimed morsel that are not read yet. */
+  std::vector<page_id_t> morsel_;
+  size_t morsel_idx_{0};
+
+  /** The page being read, and the next tuple to read in it if `has_rid_`. */
+  TablePageGuard page_;
+  RID rid_;
+  bool has_rid_{false};
+
+  /** @return false if the key of the tuple is certainly not among the build keys; a NULL key never joins */
+  auto MayJoin(const TupleView &view) const -> bool {
+    int64_t key = runtime_filter_read_(view.GetData(), runtime_filter_offset_);
+    return key != INT64_MIN && runtime_filter_->MayContain(key);
+  }
+
+  auto LimitReached() const -> bool { return plan_->limit_.has_value() && emitted_ >= *plan_->limit_; }
+
+  /** @brief Pin the next page to read. @return false if the scan has no pages left */
+  auto PinNextPage() -> bool;
+
+  /**
+   * @brief Hand the matching tuples to `emit` until it returns false.
+   * @return false if the scan ran out of tuples before that
+   */
+  template <typename Emit>
+  auto Scan(Emit &&emit) -> bool;
 };
 }  // namespace bustub
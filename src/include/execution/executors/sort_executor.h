@@ -19,12 +19,20 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * The SortExecutor executor executes a sort.
+ *
+ * Tuples are compared by their normalized sort keys (see SortKeyEncoder), which are computed once per tuple and
+ * pass. Input that fits into the memory budget of the query is sorted in memory. Otherwise the sort is an external
+ * merge sort: every time the buffered tuples exceed the budget they are sorted and written to temp pages as a run. Runs
+ * are merged MERGE_FANOUT at a time until at most MERGE_FANOUT remain, and the final merge streams its output from
+ * Next().
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -49,11 +57,49 @@ class SortExecutor : public AbstractExecutor {
   /** @return The output schema for the sort */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
+  /** The number of runs merged at once; every run being merged pins one page. */
+  static constexpr size_t MERGE_FANOUT = 16;
+
  private:
+  /** The head of a run during a merge. */
+  struct MergeEntry {
+    std::vector<uint8_t> key_;
+    Tuple tuple_;
+    size_t run_;
+  };
+
+  /** @brief Sort the buffered tuples in place. */
+  void SortTuples();
+
+  /** @return true if `left` leaves the merge after `right`: it is larger, or equal but from a later run */
+  auto MergeAfter(const MergeEntry &left, const MergeEntry &right) const -> bool;
+
+  /** @brief Sort the buffered tuples and write them out as a new run. */
+  void SpillRun();
+
+  /** @brief Start merging the runs [begin, end): fill the heap with the first tuple of each run. */
+  void StartMerge(size_t begin, size_t end);
+
+  /** @brief Pop the smallest tuple off the merge heap, refilling it from the tuple's run. */
+  auto PopMerge(Tuple *tuple) -> bool;
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
 
   std::unique_ptr<AbstractExecutor> child_executor_;
-  std::vector<Tuple> tuples_={};
+
+  SortKeyEncoder encoder_;
+
+  /** Whether Init() ran before; only the tuples of the first run live in the query arena. */
+  bool initialized_{false};
+
+  /** The tuples sorted in memory and the next one to emit. */
+  std::vector<Tuple> tuples_;
+  size_t cursor_{0};
+
+  /** Sorted runs on temp pages; empty if the sort ran in memory. */
+  std::vector<std::unique_ptr<TmpTupleFile>> runs_;
+  /** Min-heap over the heads of the runs being merged. */
+  std::vector<MergeEntry> heap_;
 };
 }  // namespace bustub
@@ -19,12 +19,19 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/scan_predicate.h"
+#include "execution/sort_key.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * The TopNExecutor executor executes a topn.
+ * The TopNExecutor executor executes a topn. It keeps the N smallest tuples seen so far in a max-heap ordered by their
+ * normalized sort keys, so a child tuple that does not make it into the heap costs one key encoding and one memcmp.
+ *
+ * When the child is a sequential scan and the first sort key an integer column, the executor registers a
+ * ScanThreshold for the scan and keeps it at the first key of the worst tuple in the full heap, so that the scan drops
+ * the tuples that cannot make it into the heap before they are copied out.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
@@ -53,7 +60,28 @@ class TopNExecutor : public AbstractExecutor {
   /** The topn plan node to be executed */
   const TopNPlanNode *plan_;
 
+  /** A tuple in the heap; `seq_` is its position in the input and breaks ties between equal keys. */
+  struct Entry {
+    std::vector<uint8_t> key_;
+    size_t seq_;
+    Tuple tuple_;
+  };
+
+  /** @return true if `left` comes before `right` in the output */
+  static auto Before(const Entry &left, const Entry &right) -> bool {
+    int cmp = SortKeyEncoder::Compare(left.key_, right.key_);
+    return cmp < 0 || (cmp == 0 && left.seq_ < right.seq_);
+  }
+
   std::unique_ptr<AbstractExecutor> child_executor_;
-  std::vector<Tuple> tuples_={};
+  SortKeyEncoder encoder_;
+  /** The top N tuples; a max-heap while reading the child, sorted afterwards. */
+  std::vector<Entry> entries_;
+  size_t cursor_{0};
+  /** The threshold of the child scan, nullptr if the child is no scan it applies to. */
+  std::unique_ptr<ScanThreshold> threshold_;
+
+  /** @brief Pass the first key of the worst tuple in the full heap down to the child scan. */
+  void UpdateThreshold();
 };
 }  // namespace bustub
@@ -18,6 +18,7 @@
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "catalog/catalog.h"
 #include "execution/plans/update_plan.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
@@ -27,6 +28,9 @@ namespace bustub {
 /**
  * UpdateExecutor executes an update on a table.
  * Updated values are always pulled from a child.
+ *
+ * A tuple is updated in place if its new version fits into its page, and is only moved, i.e. deleted and inserted
+ * anew, if it does not. The entries of an index are only replaced if the tuple moved or its key actually changed.
  */
 class UpdateExecutor : public AbstractExecutor {
   friend class UpdatePlanNode;
@@ -64,5 +68,10 @@ class UpdateExecutor : public AbstractExecutor {
   const TableInfo *table_info_;
   /** The child executor to obtain value from */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The indexes of the table */
+  std::vector<IndexInfo *> indexes_;
+  /** Whether an index has a key column that is assigned anything but its old value, one per index */
+  std::vector<bool> key_assigned_;
+  bool has_updated_{false};
 };
 }  // namespace bustub
@@ -33,6 +33,8 @@ namespace bustub {
 
 class AbstractExpression;
 using AbstractExpressionRef = std::shared_ptr<AbstractExpression>;
+class ColumnVector;
+class DataChunk;
 
 /**
  * AbstractExpression is the base class of all the expressions in the system.
@@ -65,6 +67,15 @@ class AbstractExpression {
   virtual auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                             const Schema &right_schema) const -> Value = 0;
 
+  /**
+   * Evaluate the expression over the selected rows of a chunk at once.
+   * @param chunk The input rows
+   * @param[out] result The values of the selected rows
+   * @return `false` if there is no vectorized kernel for this expression and its input types; the caller then falls
+   * back to Evaluate() for every row
+   */
+  virtual auto EvaluateVector(const DataChunk &chunk, ColumnVector *result) const -> bool { return false; }
+
   /** @return the child_idx'th child of this expression */
   auto GetChildAt(uint32_t child_idx) const -> const AbstractExpressionRef & { return children_[child_idx]; }
 
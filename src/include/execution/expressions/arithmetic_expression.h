@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <utility>
@@ -20,7 +21,9 @@
 #include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/macros.h"
+#include "execution/data_chunk.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/vector_operations.h"
 #include "fmt/format.h"
 #include "storage/table/tuple.h"
 #include "type/type_id.h"
@@ -65,6 +68,22 @@ class ArithmeticExpression : public AbstractExpression {
     return ValueFactory::GetIntegerValue(*res);
   }
 
+  auto EvaluateVector(const DataChunk &chunk, ColumnVector *result) const -> bool override {
+    ColumnVector lhs;
+    ColumnVector rhs;
+    if (!GetChildAt(0)->EvaluateVector(chunk, &lhs) || !GetChildAt(1)->EvaluateVector(chunk, &rhs)) {
+      return false;
+    }
+    switch (compute_type_) {
+      case ArithmeticType::Plus:
+        return VectorOperations::Arithmetic<std::plus<>>(lhs, rhs, chunk.GetSelection(), result);
+      case ArithmeticType::Minus:
+        return VectorOperations::Arithmetic<std::minus<>>(lhs, rhs, chunk.GetSelection(), result);
+      default:
+        return false;
+    }
+  }
+
   /** @return the string representation of the expression node and its children */
   auto ToString() const -> std::string override {
     return fmt::format("({}{}{})", *GetChildAt(0), compute_type_, *GetChildAt(1));
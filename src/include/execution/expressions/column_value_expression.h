@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/data_chunk.h"
 #include "execution/expressions/abstract_expression.h"
 #include "storage/table/tuple.h"
 
@@ -45,6 +46,15 @@ class ColumnValueExpression : public AbstractExpression {
                            : right_tuple->GetValue(&right_schema, col_idx_);
   }
 
+  auto EvaluateVector(const DataChunk &chunk, ColumnVector *result) const -> bool override {
+    const ColumnVector *column = chunk.GetColumn(col_idx_);
+    if (column == nullptr) {
+      return false;
+    }
+    *result = *column;
+    return true;
+  }
+
   auto GetTupleIdx() const -> uint32_t { return tuple_idx_; }
   auto GetColIdx() const -> uint32_t { return col_idx_; }
 
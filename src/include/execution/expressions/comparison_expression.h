@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/data_chunk.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/vector_operations.h"
 #include "fmt/format.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
@@ -49,6 +52,31 @@ class ComparisonExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
   }
 
+  auto EvaluateVector(const DataChunk &chunk, ColumnVector *result) const -> bool override {
+    ColumnVector lhs;
+    ColumnVector rhs;
+    if (!GetChildAt(0)->EvaluateVector(chunk, &lhs) || !GetChildAt(1)->EvaluateVector(chunk, &rhs)) {
+      return false;
+    }
+    const auto &sel = chunk.GetSelection();
+    switch (comp_type_) {
+      case ComparisonType::Equal:
+        return VectorOperations::Compare<std::equal_to<>>(lhs, rhs, sel, result);
+      case ComparisonType::NotEqual:
+        return VectorOperations::Compare<std::not_equal_to<>>(lhs, rhs, sel, result);
+      case ComparisonType::LessThan:
+        return VectorOperations::Compare<std::less<>>(lhs, rhs, sel, result);
+      case ComparisonType::LessThanOrEqual:
+        return VectorOperations::Compare<std::less_equal<>>(lhs, rhs, sel, result);
+      case ComparisonType::GreaterThan:
+        return VectorOperations::Compare<std::greater<>>(lhs, rhs, sel, result);
+      case ComparisonType::GreaterThanOrEqual:
+        return VectorOperations::Compare<std::greater_equal<>>(lhs, rhs, sel, result);
+      default:
+        return false;
+    }
+  }
+
   /** @return the string representation of the expression node and its children */
   auto ToString() const -> std::string override {
     return fmt::format("({}{}{})", *GetChildAt(0), comp_type_, *GetChildAt(1));
@@ -16,7 +16,9 @@
 #include <string>
 #include <vector>
 
+#include "execution/data_chunk.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/vector_operations.h"
 
 namespace bustub {
 /**
@@ -34,6 +36,10 @@ class ConstantValueExpression : public AbstractExpression {
     return val_;
   }
 
+  auto EvaluateVector(const DataChunk &chunk, ColumnVector *result) const -> bool override {
+    return VectorOperations::Broadcast(val_, chunk.GetSelection(), chunk.Size(), result);
+  }
+
   /** @return the string representation of the plan node and its children */
   auto ToString() const -> std::string override { return val_.ToString(); }
 
@@ -19,7 +19,9 @@
 #include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/macros.h"
+#include "execution/data_chunk.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/vector_operations.h"
 #include "fmt/format.h"
 #include "storage/table/tuple.h"
 #include "type/type.h"
@@ -57,6 +59,15 @@ class LogicExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComputation(lhs, rhs));
   }
 
+  auto EvaluateVector(const DataChunk &chunk, ColumnVector *result) const -> bool override {
+    ColumnVector lhs;
+    ColumnVector rhs;
+    if (!GetChildAt(0)->EvaluateVector(chunk, &lhs) || !GetChildAt(1)->EvaluateVector(chunk, &rhs)) {
+      return false;
+    }
+    return VectorOperations::Logic(logic_type_ == LogicType::And, lhs, rhs, chunk.GetSelection(), result);
+  }
+
   /** @return the string representation of the expression node and its children */
   auto ToString() const -> std::string override {
     return fmt::format("({}{}{})", *GetChildAt(0), logic_type_, *GetChildAt(1));
@@ -42,12 +42,14 @@ enum class PlanType {
   NestedLoopJoin,
   NestedIndexJoin,
   HashJoin,
+  MergeJoin,
   Filter,
   Values,
   Projection,
   Sort,
   TopN,
-  MockScan
+  MockScan,
+  Gather
 };
 
 class AbstractPlanNode;
@@ -98,12 +98,18 @@ struct AggregateKey {
   std::vector<Value> group_bys_;
 
   /**
-   * Compares two aggregate keys for equality.
+   * Compares two aggregate keys for equality. NULLs form a group of their own, so a NULL equals a NULL here.
    * @param other the other aggregate key to be compared with
    * @return `true` if both aggregate keys have equivalent group-by expressions, `false` otherwise
    */
   auto operator==(const AggregateKey &other) const -> bool {
     for (uint32_t i = 0; i < other.group_bys_.size(); i++) {
+      if (group_bys_[i].IsNull() || other.group_bys_[i].IsNull()) {
+        if (group_bys_[i].IsNull() != other.group_bys_[i].IsNull()) {
+          return false;
+        }
+        continue;
+      }
       if (group_bys_[i].CompareEquals(other.group_bys_[i]) != CmpBool::CmpTrue) {
         return false;
       }
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_plan.h
+//
+// Identification: src/include/execution/plans/gather_plan.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "execution/plans/abstract_plan.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/**
+ * Gather runs its child plan, a pipeline of filters and projections over a sequential scan, on several worker threads
+ * that split the pages of the scanned table between them, and merges their output in no particular order.
+ */
+class GatherPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new GatherPlanNode instance.
+   * @param output The output schema, the same as the one of the child
+   * @param child The scan pipeline that every worker runs
+   * @param num_workers The number of worker threads
+   */
+  GatherPlanNode(SchemaRef output, AbstractPlanNodeRef child, size_t num_workers)
+      : AbstractPlanNode(std::move(output), {std::move(child)}), num_workers_(num_workers) {}
+
+  /** @return The type of the plan node */
+  auto GetType() const -> PlanType override { return PlanType::Gather; }
+
+  /** @return The number of worker threads */
+  auto GetNumWorkers() const -> size_t { return num_workers_; }
+
+  /** @return The child plan node */
+  auto GetChildPlan() const -> AbstractPlanNodeRef {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Gather should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(GatherPlanNode);
+
+  /** The number of worker threads */
+  size_t num_workers_;
+
+ protected:
+  auto PlanNodeToString() const -> std::string override { return fmt::format("Gather {{ workers={} }}", num_workers_); }
+};
+
+}  // namespace bustub
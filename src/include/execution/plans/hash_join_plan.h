@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -76,8 +77,15 @@ class HashJoinPlanNode : public AbstractPlanNode {
   /** The join type */
   JoinType join_type_;
 
+  /** The runtime filter that the join builds over its build keys for a scan on its probe side, if any. */
+  std::optional<size_t> runtime_filter_;
+
  protected:
   auto PlanNodeToString() const -> std::string override {
+    if (runtime_filter_) {
+      return fmt::format("HashJoin {{ type={}, left_key={}, right_key={}, runtime_filter={} }}", join_type_,
+                         left_key_expression_, right_key_expression_, *runtime_filter_);
+    }
     return fmt::format("HashJoin {{ type={}, left_key={}, right_key={} }}", join_type_, left_key_expression_,
                        right_key_expression_);
   }
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -21,33 +22,49 @@
 
 namespace bustub {
 /**
- * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ * IndexScanPlanNode identifies a table that should be scanned through an index. Without a lookup key the whole
+ * index is walked in key order (B+ tree only); with a lookup key only the matching entries are fetched.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
   /**
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to be scanned
+   * @param lookup_key optional constant expression; when set, only entries whose key equals it are returned
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, AbstractExpressionRef lookup_key = nullptr)
+      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid), lookup_key_(std::move(lookup_key)) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
   /** @return the identifier of the table that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
+  /** @return the point lookup key, or nullptr for a full ordered scan */
+  auto GetLookupKey() const -> const AbstractExpressionRef & { return lookup_key_; }
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
-  // Add anything you want here for index lookup
+  /** The key to look up, nullptr when scanning the whole index. */
+  AbstractExpressionRef lookup_key_;
+
+  /** The number of tuples after which the scan may stop, pushed down from a LIMIT above it. */
+  std::optional<size_t> limit_;
 
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    std::string output = fmt::format("IndexScan {{ index_oid={}", index_oid_);
+    if (lookup_key_) {
+      output += fmt::format(", lookup_key={}", lookup_key_);
+    }
+    if (limit_) {
+      output += fmt::format(", limit={}", *limit_);
+    }
+    return output + " }";
   }
 };
 
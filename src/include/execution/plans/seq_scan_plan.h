@@ -13,6 +13,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -62,12 +63,26 @@ class SeqScanPlanNode : public AbstractPlanNode {
   */
   AbstractExpressionRef filter_predicate_;
 
+  /** The number of tuples after which the scan may stop, pushed down from a LIMIT above it. */
+  std::optional<size_t> limit_;
+
+  /** The runtime filter of a hash join above that the scan checks `runtime_filter_column_` against, if any. */
+  std::optional<size_t> runtime_filter_;
+  uint32_t runtime_filter_column_{0};
+
  protected:
   auto PlanNodeToString() const -> std::string override {
+    std::string output = fmt::format("SeqScan {{ table={}", table_name_);
     if (filter_predicate_) {
-      return fmt::format("SeqScan {{ table={}, filter={} }}", table_name_, filter_predicate_);
+      output += fmt::format(", filter={}", filter_predicate_);
+    }
+    if (limit_) {
+      output += fmt::format(", limit={}", *limit_);
+    }
+    if (runtime_filter_) {
+      output += fmt::format(", runtime_filter={} on #0.{}", *runtime_filter_, runtime_filter_column_);
     }
-    return fmt::format("SeqScan {{ table={} }}", table_name_);
+    return output + " }";
   }
 };
 
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// runtime_filter.h
+//
+// Identification: src/include/execution/runtime_filter.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/util/hash_util.h"
+
+namespace bustub {
+
+/**
+ * RuntimeFilter is a blocked Bloom filter over the integer join keys of a hash join's build side.
+ *
+ * The join builds it once it has read its build side and publishes it to the sequential scan on the probe side, which
+ * drops the tuples whose key is certainly not among the build keys before copying them out. A key maps to one 32 byte
+ * block and sets one bit in each of the block's eight 32-bit words, so a lookup touches a single cache line and its
+ * eight word tests have no dependencies between them, which compilers turn into a few vector instructions.
+ */
+class RuntimeFilter {
+ public:
+  /** The filter size per build key; 16 bits with 8 bits set per key give well under 1% false positives. */
+  static constexpr size_t BITS_PER_KEY = 16;
+
+  /** @brief Size the filter for the keys and insert them. The keys must not be NULL. */
+  void Build(const std::vector<int64_t> &keys);
+
+  /** @brief Forget the keys; the filter passes nothing until it is built again. */
+  void Reset() {
+    blocks_.clear();
+    built_ = false;
+  }
+
+  /** @return true once Build() ran */
+  auto IsBuilt() const -> bool { return built_; }
+
+  /** @return false if the key is certainly not in the filter */
+  auto MayContain(int64_t key) const -> bool {
+    if (blocks_.empty()) {
+      return false;
+    }
+    const uint64_t hash = HashUtil::MixHash(static_cast<uint64_t>(key));
+    const Block &block = blocks_[BlockOf(hash)];
+    const auto low = static_cast<uint32_t>(hash);
+    uint32_t missing = 0;
+    for (size_t i = 0; i < WORDS_PER_BLOCK; i++) {
+      missing |= ~block.words_[i] & BitOf(low, i);
+    }
+    return missing == 0;
+  }
+
+  /** @return The memory the filter takes */
+  auto Bytes() const -> size_t { return blocks_.size() * sizeof(Block); }
+
+ private:
+  static constexpr size_t WORDS_PER_BLOCK = 8;
+
+  struct alignas(32) Block {
+    uint32_t words_[WORDS_PER_BLOCK];
+  };
+
+  /** Odd multipliers that derive the bit positions of a key in the eight words from one 32-bit hash. */
+  static constexpr uint32_t SALTS[WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+  /** @return The bit of the key in the i-th word of its block */
+  static auto BitOf(uint32_t low, size_t i) -> uint32_t { return 1U << ((low * SALTS[i]) >> 27); }
+
+  /** @return The block of the key, picked by the high half of its hash */
+  auto BlockOf(uint64_t hash) const -> size_t { return ((hash >> 32) * blocks_.size()) >> 32; }
+
+  std::vector<Block> blocks_;
+  bool built_{false};
+};
+
+}  // namespace bustub
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// scan_predicate.h
+//
+// Identification: src/include/execution/scan_predicate.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/compiled_expression.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+/**
+ * ScanPredicate is the filter predicate of a sequential scan, evaluated on the tuples in place in their pages.
+ *
+ * The conjuncts of the form `integer column <op> integer constant` (either way round) become kernels: functions
+ * instantiated per column type and comparison that read the column straight out of the tuple bytes and compare it with
+ * the constant. Whatever is left (strings, arithmetic, ORs, ...) forms the residual predicate, which is evaluated on
+ * the tuples that pass the kernels. Either way the scan copies out only the tuples that match.
+ */
+class ScanPredicate {
+ public:
+  /**
+   * Split a filter predicate of a scan.
+   * @param predicate The predicate, may be nullptr
+   * @param schema The schema of the scanned table
+   */
+  ScanPredicate(const AbstractExpressionRef &predicate, const Schema *schema);
+
+  /** @return true if the tuple passes the predicate (true if there is none) */
+  auto Matches(const TupleView &view) const -> bool;
+
+  /** @return The number of conjuncts turned into kernels */
+  auto KernelCount() const -> size_t { return kernels_.size(); }
+
+ private:
+  /** Compares the column at `offset` of the tuple data with `constant`; false if the column is NULL. */
+  using KernelFn = auto (*)(const char *data, uint32_t offset, int64_t constant) -> bool;
+
+  struct Kernel {
+    KernelFn fn_;
+    uint32_t offset_;
+    int64_t constant_;
+  };
+
+  /** @brief Turn the conjunct into a kernel if it has the right form. @return false if it has not */
+  auto AddKernel(const AbstractExpression &conjunct) -> bool;
+
+  const Schema *schema_;
+  std::vector<Kernel> kernels_;
+  AbstractExpressionRef residual_;
+  std::unique_ptr<CompiledExpression> residual_program_;
+};
+
+/** Reads an integer column at `offset` of the tuple data as an int64_t, INT64_MIN if the column is NULL. */
+using IntegerColumnReader = auto (*)(const char *data, uint32_t offset) -> int64_t;
+
+/** @return The reader of integer columns of the type, nullptr if it is no integer type */
+auto IntegerColumnReaderFor(TypeId type) -> IntegerColumnReader;
+
+/**
+ * ScanThreshold is the running cut-off that a TopN passes down to the sequential scan below it.
+ *
+ * Once the heap of the TopN is full, a tuple can only enter it if its first sort key is not worse than the key of the
+ * worst tuple in the heap. The TopN publishes that key here whenever it changes, and the scan drops the tuples that
+ * are beyond it before evaluating the filter or copying them out. Only integer keys that are plain columns of the
+ * scanned table are supported. NULLs sort first in ascending order and last in descending order, i.e. as the smallest
+ * value either way.
+ */
+class ScanThreshold {
+ public:
+  /**
+   * @param column The sort key column of the scanned table
+   * @param descending true if the TopN keeps the largest keys
+   */
+  ScanThreshold(const Column &column, bool descending);
+
+  /** @return true if the column can serve as a threshold key */
+  static auto Supports(const Column &column) -> bool {
+    return IntegerColumnReaderFor(column.GetType()) != nullptr;
+  }
+
+  /** @brief Let every tuple pass again, e.g. when the TopN starts over. */
+  void Reset() { active_ = false; }
+
+  /** @brief Drop the tuples whose key is beyond `key` from now on. */
+  void Update(const Value &key);
+
+  /** @return false if the tuple cannot make it into the TopN */
+  auto Passes(const TupleView &view) const -> bool {
+    if (!active_) {
+      return true;
+    }
+    int64_t key = read_(view.GetData(), offset_);
+    return descending_ ? key >= bound_ : key <= bound_;
+  }
+
+ private:
+  IntegerColumnReader read_;
+  uint32_t offset_;
+  bool descending_;
+  bool active_{false};
+  int64_t bound_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "catalog/schema.h"
+#include "execution/compiled_expression.h"
+#include "execution/expressions/abstract_expression.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SortKeyEncoder turns the ORDER BY values of a tuple into a byte string whose memcmp order is the sort order, so that
+ * sorting compares bytes instead of evaluating expressions and comparing Values.
+ *
+ * Every ORDER BY column is encoded with NormalizedKey; the bytes of a DESC column are inverted. NULL is the smallest
+ * value: it comes first in ascending and last in descending order.
+ */
+class SortKeyEncoder {
+ public:
+  SortKeyEncoder(const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys, const Schema &schema)
+      : order_bys_(order_bys), schema_(schema) {
+    for (const auto &[order_by_type, expr] : order_bys_) {
+      programs_.push_back(CompiledExpression::Compile(*expr, schema_));
+    }
+  }
+
+  /** @brief Append the sort key of the tuple to `out`. */
+  void Encode(const Tuple &tuple, std::vector<uint8_t> *out) const;
+
+  /** @brief Replace `out` with the sort key of the tuple. */
+  void EncodeKey(const Tuple &tuple, std::vector<uint8_t> *out) const {
+    out->clear();
+    Encode(tuple, out);
+  }
+
+  /**
+   * @brief Compute the order of the tuples. All keys are encoded once into one buffer and the tuple indexes are
+   * sorted by memcmp on the keys; equal keys keep their input order.
+   * @return The tuple indexes in sorted order
+   */
+  auto SortPermutation(const std::vector<Tuple> &tuples) const -> std::vector<uint32_t>;
+
+  /** @return A negative number, zero or a positive number if key `left` sorts before, with or after key `right` */
+  static auto Compare(const std::vector<uint8_t> &left, const std::vector<uint8_t> &right) -> int {
+    return Compare(left.data(), left.size(), right.data(), right.size());
+  }
+
+  static auto Compare(const uint8_t *left, size_t left_len, const uint8_t *right, size_t right_len) -> int {
+    int cmp = memcmp(left, right, std::min(left_len, right_len));
+    if (cmp != 0) {
+      return cmp;
+    }
+    return left_len < right_len ? -1 : static_cast<int>(left_len > right_len);
+  }
+
+ private:
+  const std::vector<std::pair<OrderByType, AbstractExpressionRef>> &order_bys_;
+  const Schema &schema_;
+  /** Every ORDER BY expression compiled to bytecode, or nullptr where it does not compile */
+  std::vector<std::unique_ptr<CompiledExpression>> programs_;
+};
+
+}  // namespace bustub
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+/**
+ * TupleBatch is a fixed-capacity batch of tuples that executors hand to their parent with NextBatch().
+ *
+ * The slots of a batch survive Reset(): a tuple copied into a slot that already holds a tuple of the same length
+ * reuses its buffer, so refilling a batch in a loop does not allocate for fixed-length rows.
+ */
+class TupleBatch {
+ public:
+  explicit TupleBatch(size_t capacity = BUSTUB_BATCH_SIZE) : tuples_(capacity), rids_(capacity) {}
+
+  /** @brief Empty the batch, keeping the slots for reuse. */
+  void Reset() { size_ = 0; }
+
+  /** @return The number of tuples in the batch */
+  auto Size() const -> size_t { return size_; }
+
+  /** @return The number of tuples the batch can hold */
+  auto Capacity() const -> size_t { return tuples_.size(); }
+
+  auto IsEmpty() const -> bool { return size_ == 0; }
+
+  auto IsFull() const -> bool { return size_ == tuples_.size(); }
+
+  /** @brief Copy a tuple into the next slot. */
+  void Append(const Tuple &tuple, RID rid) {
+    BUSTUB_ASSERT(!IsFull(), "batch is full");
+    tuples_[size_] = tuple;
+    rids_[size_] = rid;
+    size_++;
+  }
+
+  /** @brief Move a tuple into the next slot. */
+  void Append(Tuple &&tuple, RID rid) {
+    BUSTUB_ASSERT(!IsFull(), "batch is full");
+    tuples_[size_] = std::move(tuple);
+    rids_[size_] = rid;
+    size_++;
+  }
+
+  /** @brief Copy a tuple read in place from a page into the next slot. */
+  void Append(const TupleView &view) {
+    BUSTUB_ASSERT(!IsFull(), "batch is full");
+    view.MaterializeInto(&tuples_[size_]);
+    rids_[size_] = view.GetRid();
+    size_++;
+  }
+
+  auto GetTuple(size_t idx) -> Tuple & { return tuples_[idx]; }
+
+  auto GetTuple(size_t idx) const -> const Tuple & { return tuples_[idx]; }
+
+  auto GetRid(size_t idx) const -> RID { return rids_[idx]; }
+
+  /**
+   * @brief Keep only the tuples whose `keep(tuple)` is true, preserving their order. Dropped slots stay allocated
+   * behind the end of the batch.
+   */
+  template <typename Predicate>
+  void Retain(Predicate &&keep) {
+    size_t kept = 0;
+    for (size_t i = 0; i < size_; i++) {
+      if (keep(tuples_[i])) {
+        if (kept != i) {
+          std::swap(tuples_[kept], tuples_[i]);
+          rids_[kept] = rids_[i];
+        }
+        kept++;
+      }
+    }
+    size_ = kept;
+  }
+
+  /** @brief Keep only the rows listed in `sel`, which must be in ascending order. */
+  void Select(const std::vector<uint32_t> &sel) {
+    for (size_t i = 0; i < sel.size(); i++) {
+      if (sel[i] != i) {
+        std::swap(tuples_[i], tuples_[sel[i]]);
+        rids_[i] = rids_[sel[i]];
+      }
+    }
+    size_ = sel.size();
+  }
+
+ private:
+  std::vector<Tuple> tuples_;
+  std::vector<RID> rids_;
+  size_t size_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// vector_operations.h
+//
+// Identification: src/include/execution/vector_operations.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <type_traits>
+
+#include "execution/data_chunk.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * VectorOperations are the kernels behind AbstractExpression::EvaluateVector(). Each one runs a tight loop over the
+ * selected rows of its inputs and writes the same rows of the result. All of them return false for input types they
+ * have no kernel for; the caller then evaluates row by row.
+ */
+class VectorOperations {
+ public:
+  /** @brief Fill the selected rows with a constant. */
+  static auto Broadcast(const Value &value, const SelectionVector &sel, size_t size, ColumnVector *result) -> bool {
+    return DispatchFixedType(value.GetTypeId(), [&](auto tag) {
+      using T = decltype(tag);
+      result->Initialize(value.GetTypeId(), size);
+      T *out = result->GetData<T>();
+      const T constant = value.GetAs<T>();
+      const bool is_null = value.IsNull();
+      for (auto idx : sel) {
+        out[idx] = constant;
+        if (is_null) {
+          result->SetNull(idx);
+        }
+      }
+    });
+  }
+
+  /** @brief Convert the selected rows to another numeric type. */
+  static auto Cast(const ColumnVector &input, TypeId type, const SelectionVector &sel, ColumnVector *result) -> bool {
+    return DispatchFixedType(input.GetType(), [&](auto from_tag) {
+      DispatchFixedType(type, [&](auto to_tag) {
+        using From = decltype(from_tag);
+        using To = decltype(to_tag);
+        result->Initialize(type, input.Size());
+        const From *in = input.GetData<From>();
+        To *out = result->GetData<To>();
+        for (auto idx : sel) {
+          out[idx] = static_cast<To>(in[idx]);
+        }
+        result->MergeNulls(input);
+      });
+    });
+  }
+
+  /**
+   * @brief Compare two vectors row by row into a BOOLEAN vector. Integers of different widths are compared as
+   * BIGINT, integers against decimals as DECIMAL.
+   * @tparam Op a comparison functor such as std::less<>
+   */
+  template <typename Op>
+  static auto Compare(const ColumnVector &lhs, const ColumnVector &rhs, const SelectionVector &sel,
+                      ColumnVector *result) -> bool {
+    ColumnVector lhs_cast;
+    ColumnVector rhs_cast;
+    const ColumnVector *left;
+    const ColumnVector *right;
+    if (!Promote(lhs, rhs, sel, &lhs_cast, &rhs_cast, &left, &right)) {
+      return false;
+    }
+    return DispatchFixedType(left->GetType(), [&](auto tag) {
+      using T = decltype(tag);
+      result->Initialize(TypeId::BOOLEAN, lhs.Size());
+      const T *l = left->GetData<T>();
+      const T *r = right->GetData<T>();
+      auto *out = result->GetData<int8_t>();
+      Op op;
+      for (auto idx : sel) {
+        out[idx] = static_cast<int8_t>(op(l[idx], r[idx]));
+      }
+      result->MergeNulls(*left);
+      result->MergeNulls(*right);
+    });
+  }
+
+  /**
+   * @brief Combine two numeric vectors row by row. Integer arithmetic wraps around; a result that hits the NULL
+   * sentinel of its type reads back as NULL, just like a Value built from it.
+   * @tparam Op an arithmetic functor such as std::plus<>
+   */
+  template <typename Op>
+  static auto Arithmetic(const ColumnVector &lhs, const ColumnVector &rhs, const SelectionVector &sel,
+                         ColumnVector *result) -> bool {
+    if (lhs.GetType() == TypeId::BOOLEAN || lhs.GetType() == TypeId::TIMESTAMP) {
+      return false;
+    }
+    ColumnVector lhs_cast;
+    ColumnVector rhs_cast;
+    const ColumnVector *left;
+    const ColumnVector *right;
+    if (!Promote(lhs, rhs, sel, &lhs_cast, &rhs_cast, &left, &right)) {
+      return false;
+    }
+    return DispatchFixedType(left->GetType(), [&](auto tag) {
+      using T = decltype(tag);
+      const TypeId type = left->GetType();
+      result->Initialize(type, lhs.Size());
+      const T *l = left->GetData<T>();
+      const T *r = right->GetData<T>();
+      T *out = result->GetData<T>();
+      Op op;
+      const T null = NullSentinel<T>(type);
+      for (auto idx : sel) {
+        if constexpr (std::is_integral_v<T>) {
+          using U = std::make_unsigned_t<T>;
+          out[idx] = static_cast<T>(static_cast<U>(op(static_cast<U>(l[idx]), static_cast<U>(r[idx]))));
+        } else {
+          out[idx] = op(l[idx], r[idx]);
+        }
+        if (out[idx] == null) {
+          result->SetNull(idx);
+        }
+      }
+      result->MergeNulls(*left);
+      result->MergeNulls(*right);
+    });
+  }
+
+  /** @brief Three-valued AND (`is_and`) or OR of two BOOLEAN vectors. */
+  static auto Logic(bool is_and, const ColumnVector &lhs, const ColumnVector &rhs, const SelectionVector &sel,
+                    ColumnVector *result) -> bool {
+    if (lhs.GetType() != TypeId::BOOLEAN || rhs.GetType() != TypeId::BOOLEAN) {
+      return false;
+    }
+    result->Initialize(TypeId::BOOLEAN, lhs.Size());
+    const auto *l = lhs.GetData<int8_t>();
+    const auto *r = rhs.GetData<int8_t>();
+    auto *out = result->GetData<int8_t>();
+    // A dominating operand (false for AND, true for OR) decides the row even if the other one is NULL.
+    const bool dominant = !is_and;
+    for (auto idx : sel) {
+      bool l_null = lhs.IsNull(idx);
+      bool r_null = rhs.IsNull(idx);
+      bool l_val = l[idx] != 0;
+      bool r_val = r[idx] != 0;
+      if ((!l_null && l_val == dominant) || (!r_null && r_val == dominant)) {
+        out[idx] = static_cast<int8_t>(dominant);
+      } else if (l_null || r_null) {
+        out[idx] = 0;
+        result->SetNull(idx);
+      } else {
+        out[idx] = static_cast<int8_t>(!dominant);
+      }
+    }
+    return true;
+  }
+
+ private:
+  /** @brief Bring two vectors to a common type, casting into the scratch vectors where needed. */
+  static auto Promote(const ColumnVector &lhs, const ColumnVector &rhs, const SelectionVector &sel,
+                      ColumnVector *lhs_cast, ColumnVector *rhs_cast, const ColumnVector **left,
+                      const ColumnVector **right) -> bool {
+    *left = &lhs;
+    *right = &rhs;
+    if (lhs.GetType() == rhs.GetType()) {
+      return true;
+    }
+    auto is_integer = [](TypeId type) {
+      return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+    };
+    TypeId common;
+    if (is_integer(lhs.GetType()) && is_integer(rhs.GetType())) {
+      common = TypeId::BIGINT;
+    } else if ((is_integer(lhs.GetType()) || lhs.GetType() == TypeId::DECIMAL) &&
+               (is_integer(rhs.GetType()) || rhs.GetType() == TypeId::DECIMAL)) {
+      common = TypeId::DECIMAL;
+    } else {
+      return false;
+    }
+    if (lhs.GetType() != common) {
+      Cast(lhs, common, sel, lhs_cast);
+      *left = lhs_cast;
+    }
+    if (rhs.GetType() != common) {
+      Cast(rhs, common, sel, rhs_cast);
+      *right = rhs_cast;
+    }
+    return true;
+  }
+};
+
+}  // namespace bustub
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/config.h"
 #include "concurrency/transaction.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
@@ -24,8 +25,8 @@ namespace bustub {
  */
 class Optimizer {
  public:
-  explicit Optimizer(const Catalog &catalog, bool force_starter_rule)
-      : catalog_(catalog), force_starter_rule_(force_starter_rule) {}
+  explicit Optimizer(const Catalog &catalog, bool force_starter_rule, size_t scan_threads = PARALLEL_SCAN_THREADS)
+      : catalog_(catalog), force_starter_rule_(force_starter_rule), scan_threads_(scan_threads) {}
 
   auto Optimize(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
@@ -88,15 +89,53 @@ class Optimizer {
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief optimize `column = constant` filter over seq scan as an index point lookup
+   */
+  auto OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /** @brief check if the index can be matched */
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
       -> std::optional<std::tuple<index_oid_t, std::string>>;
 
+  /**
+   * @brief optimize hash join as merge join when both inputs are already produced in the order of their join keys,
+   * e.g. by a sort or by an ordered B+ tree index scan
+   */
+  auto OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief let inner hash joins on integer keys publish a runtime filter over their build keys to the sequential scan
+   * that produces the probe key, so that the scan drops tuples without a match before they reach the join
+   */
+  auto OptimizeHashJoinRuntimeFilter(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @brief check if the plan is known to produce its tuples in ascending order of the column */
+  auto IsOrderedOn(const AbstractPlanNode &plan, uint32_t col_idx) -> bool;
+
   /**
    * @brief optimize sort + limit as top N
    */
   auto OptimizeSortLimitAsTopN(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
+  /**
+   * @brief optimize top N over an input that already comes in the order of its single ascending key as a limit, which
+   * stops reading the input after N tuples
+   */
+  auto OptimizeOrderedTopNAsLimit(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief push limits down through projections into the sequential or index scan below them, so that the scan stops
+   * after the tuples the limit takes instead of filling a whole batch
+   */
+  auto OptimizeLimitPushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief run pipelines of filters and projections over sequential scans on `scan_threads_` workers by putting a
+   * gather on top of them
+   */
+  auto OptimizeParallelScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
   /**
    * @brief get the estimated cardinality for a table based on the table name. Useful when join reordering. BusTub
    * doesn't support statistics for now, so it's the only way for you to get the table size :(
@@ -112,6 +151,9 @@ class Optimizer {
   const Catalog &catalog_;
 
   const bool force_starter_rule_;
+
+  /** The number of worker threads of a sequential scan; scans are not parallelized if it is 1. */
+  const size_t scan_threads_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_index.h
+//
+// Identification: src/include/storage/index/art_index.h
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "container/art/adaptive_radix_tree.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+#define ART_INDEX_TYPE ArtIndex<KeyType, ValueType, KeyComparator>
+
+/**
+ * ArtIndex is an in-memory index over an AdaptiveRadixTree. Keys are stored as their NormalizedKey encoding, so the
+ * tree orders them like the key comparator would. Nothing goes through the buffer pool and the index is not
+ * persisted, which makes it a fit for in-memory tables and temporary indexes.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+class ArtIndex : public Index {
+ public:
+  ArtIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
+
+  ~ArtIndex() override = default;
+
+  void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+ protected:
+  /** @brief Encode the key tuple the way the tree stores it. */
+  void EncodeKey(const Tuple &key, std::vector<uint8_t> *normalized) const;
+
+  // container
+  AdaptiveRadixTree<ValueType> container_;
+};
+
+}  // namespace bustub
@@ -12,6 +12,7 @@
 
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "concurrency/transaction.h"
@@ -51,6 +52,15 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   auto Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr) -> bool;
 
+  // Insert a batch of key-value pairs, preferably sorted by key; a key that falls into the leaf of the previous key is
+  // inserted there directly as long as the leaf does not have to split
+  void InsertBatch(const std::vector<KeyType> &keys, const std::vector<ValueType> &values,
+                   Transaction *transaction = nullptr);
+
+  // Descend to the leaf of the key for an insert; returns it write latched if it takes one more key without a split,
+  // nullptr with all latches released otherwise
+  auto LatchSafeLeaf(const KeyType &key, Transaction *transaction) -> LeafPage *;
+
   // Remove a key and its value from this B+ tree.
   void Remove(const KeyType &key, Transaction *transaction = nullptr);
 
@@ -71,6 +81,11 @@ class BPlusTree {
   // return the value associated with a given key
   auto GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr) -> bool;
 
+  // return the values associated with a batch of keys as (position in `keys`, value) pairs; a key that falls into the
+  // leaf of the previous key is looked up there instead of descending from the root again
+  void GetValues(const std::vector<KeyType> &keys, std::vector<std::pair<size_t, ValueType>> *result,
+                 Transaction *transaction = nullptr);
+
   // return the page id of the root node
   auto GetRootPageId() -> page_id_t;
 
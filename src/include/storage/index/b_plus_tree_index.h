@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "container/hash/hash_function.h"
@@ -31,10 +32,15 @@ class BPlusTreeIndex : public Index {
 
   void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
+  void InsertEntries(const std::vector<Tuple> &keys, const std::vector<RID> &rids, Transaction *transaction) override;
+
   void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::pair<size_t, RID>> *result,
+                Transaction *transaction) override;
+
   auto GetBeginIterator() -> INDEXITERATOR_TYPE;
 
   auto GetBeginIterator(const KeyType &key) -> INDEXITERATOR_TYPE;
@@ -159,6 +159,19 @@ class Index {
    */
   virtual void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) = 0;
 
+  /**
+   * Insert a batch of entries into the index. Indexes that keep their keys ordered sort the batch and insert runs of
+   * keys that fall into the same page at once, faster than one InsertEntry() each.
+   * @param keys The index keys
+   * @param rids The RIDs associated with the keys, one per key
+   * @param transaction The transaction context
+   */
+  virtual void InsertEntries(const std::vector<Tuple> &keys, const std::vector<RID> &rids, Transaction *transaction) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      InsertEntry(keys[i], rids[i], transaction);
+    }
+  }
+
   /**
    * Delete an index entry by key.
    * @param key The index key
@@ -175,6 +188,25 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  /**
+   * Search the index for a batch of keys. Indexes that keep their keys ordered can serve keys in ascending order
+   * faster than one ScanKey() each.
+   * @param keys The index keys
+   * @param result The collection of (position in `keys`, RID) pairs that is populated with results of the search
+   * @param transaction The transaction context
+   */
+  virtual void ScanKeys(const std::vector<Tuple> &keys, std::vector<std::pair<size_t, RID>> *result,
+                        Transaction *transaction) {
+    std::vector<RID> rids;
+    for (size_t i = 0; i < keys.size(); i++) {
+      rids.clear();
+      ScanKey(keys[i], &rids, transaction);
+      for (const auto &rid : rids) {
+        result->emplace_back(i, rid);
+      }
+    }
+  }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
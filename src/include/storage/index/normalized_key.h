@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// normalized_key.h
+//
+// Identification: src/include/storage/index/normalized_key.h
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "storage/index/generic_key.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * NormalizedKey encodes key values into byte strings whose lexicographic (memcmp) order is the order of the values.
+ *
+ * Every column starts with a null indicator byte (0 for NULL, 1 otherwise), so NULLs sort first. Integers are stored
+ * big-endian with the sign bit flipped, decimals are stored as their IEEE bits with the sign bit flipped for positive
+ * numbers and all bits flipped for negative ones, and VARCHARs escape 0x00 as 0x00 0xFF and end with 0x00 0x00.
+ *
+ * Keys encoded from the same schema are prefix-free: no encoded key is a proper prefix of another one.
+ */
+class NormalizedKey {
+ public:
+  /** @brief Append the encoding of a single value to `out`. */
+  static void AppendValue(const Value &value, std::vector<uint8_t> *out);
+
+  /** @brief Encode all columns of a key tuple laid out in `key_schema`, replacing the contents of `out`. */
+  static void FromTuple(const Tuple &key, const Schema &key_schema, std::vector<uint8_t> *out) {
+    out->clear();
+    for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+      AppendValue(key.GetValue(&key_schema, i), out);
+    }
+  }
+
+  /** @brief Encode all columns of a GenericKey laid out in `key_schema`, replacing the contents of `out`. */
+  template <size_t KeySize>
+  static void FromGenericKey(const GenericKey<KeySize> &key, Schema *key_schema, std::vector<uint8_t> *out) {
+    out->clear();
+    for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+      AppendValue(key.ToValue(key_schema, i), out);
+    }
+  }
+};
+
+}  // namespace bustub
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.h
+//
+// Identification: src/include/storage/page/free_space_map_page.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "storage/page/page.h"
+
+namespace bustub {
+
+/**
+ * FreeSpaceMapPage records how much free space the pages of a table heap have, one byte per heap page.
+ *
+ * The free space is kept in categories of FREE_SPACE_CATEGORY_SIZE bytes, rounded down, so a page in category c has at
+ * least c * FREE_SPACE_CATEGORY_SIZE bytes free. The pages of a map are chained by their next page id.
+ *
+ * FreeSpaceMapPage format:
+ *
+ * Sizes are in bytes.
+ * | PageId (4) | LSN (4) | NextPageId (4) | Count (4) | HeapPageId_0 | ... | HeapPageId_N-1 | Category_0 | ... |
+ */
+class FreeSpaceMapPage : public Page {
+ public:
+  /** The number of bytes per free space category. */
+  static constexpr uint32_t FREE_SPACE_CATEGORY_SIZE = BUSTUB_PAGE_SIZE / 256;
+  /** The number of heap pages a map page records. */
+  static constexpr uint32_t CAPACITY = (BUSTUB_PAGE_SIZE - 16) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+  /** @return The category of a page with `free_bytes` free, rounded down */
+  static auto CategoryOf(uint32_t free_bytes) -> uint8_t {
+    uint32_t category = free_bytes / FREE_SPACE_CATEGORY_SIZE;
+    return category > UINT8_MAX ? UINT8_MAX : static_cast<uint8_t>(category);
+  }
+
+  /** @return The lowest category whose pages surely have `bytes` free */
+  static auto CategoryFor(uint32_t bytes) -> uint32_t {
+    return (bytes + FREE_SPACE_CATEGORY_SIZE - 1) / FREE_SPACE_CATEGORY_SIZE;
+  }
+
+  void Init(page_id_t page_id) {
+    memcpy(GetData() + OFFSET_PAGE_ID, &page_id, sizeof(page_id_t));
+    SetNextPageId(INVALID_PAGE_ID);
+    SetCount(0);
+  }
+
+  auto GetNextPageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  /** @return The number of heap pages recorded on this page */
+  auto GetCount() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_COUNT); }
+
+  auto GetHeapPageId(uint32_t slot) -> page_id_t {
+    return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_HEAP_PAGE_IDS + sizeof(page_id_t) * slot);
+  }
+
+  auto GetCategory(uint32_t slot) -> uint8_t {
+    return *reinterpret_cast<uint8_t *>(GetData() + OFFSET_CATEGORIES + slot);
+  }
+
+  void SetCategory(uint32_t slot, uint8_t category) { GetData()[OFFSET_CATEGORIES + slot] = category; }
+
+  /**
+   * Record another heap page.
+   * @return The slot of the page, or CAPACITY if this map page is full
+   */
+  auto Append(page_id_t heap_page_id, uint8_t category) -> uint32_t {
+    uint32_t slot = GetCount();
+    if (slot == CAPACITY) {
+      return CAPACITY;
+    }
+    memcpy(GetData() + OFFSET_HEAP_PAGE_IDS + sizeof(page_id_t) * slot, &heap_page_id, sizeof(page_id_t));
+    SetCategory(slot, category);
+    SetCount(slot + 1);
+    return slot;
+  }
+
+ private:
+  static constexpr size_t OFFSET_PAGE_ID = 0;
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 8;
+  static constexpr size_t OFFSET_COUNT = 12;
+  static constexpr size_t OFFSET_HEAP_PAGE_IDS = 16;
+  static constexpr size_t OFFSET_CATEGORIES = OFFSET_HEAP_PAGE_IDS + sizeof(page_id_t) * CAPACITY;
+
+  void SetCount(uint32_t count) { memcpy(GetData() + OFFSET_COUNT, &count, sizeof(uint32_t)); }
+
+  static_assert(sizeof(page_id_t) == 4);
+  static_assert(OFFSET_CATEGORIES + CAPACITY <= BUSTUB_PAGE_SIZE);
+};
+
+}  // namespace bustub
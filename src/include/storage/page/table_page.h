@@ -19,6 +19,7 @@
 #include "recovery/log_manager.h"
 #include "storage/page/page.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 
 static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
 
@@ -123,6 +124,14 @@ class TablePage : public Page {
    */
   auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) -> bool;
 
+  /**
+   * Read a tuple from a table in place, without copying it.
+   * @param rid rid of the tuple to read
+   * @param[out] view the view of the tuple, valid while the page is pinned and latched
+   * @return true if the tuple exists
+   */
+  auto GetTupleView(const RID &rid, TupleView *view) -> bool;
+
   /** @return the rid of the first tuple in this page */
 
   /**
@@ -138,6 +147,28 @@ class TablePage : public Page {
    */
   auto GetNextTupleRid(const RID &cur_rid, RID *next_rid) -> bool;
 
+  /** @return the number of free bytes between the slot array and the tuple data */
+  auto GetFreeSpaceRemaining() -> uint32_t {
+    return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
+  }
+
+  /** @return the free bytes an insert of a tuple of `tuple_size` bytes needs, its slot included */
+  static auto SpaceNeeded(uint32_t tuple_size) -> uint32_t { return tuple_size + SIZE_TUPLE; }
+
+  /** @return the bytes that Compact() would reclaim: gaps between the tuples and the empty slots at the end */
+  auto GetDeadSpace() -> uint32_t;
+
+  /**
+   * Defragment the page: pack the tuples against the end of the page and drop the empty slots at the end of the slot
+   * array. The slot of a tuple never changes, as RIDs point at it; empty slots before the last used one stay for
+   * InsertTuple() to reuse.
+   * @return the number of bytes reclaimed
+   */
+  auto Compact() -> uint32_t;
+
+  /** @return true if a tuple on the page is marked deleted, i.e. its delete has not been applied yet */
+  auto HasPendingDeletes() -> bool;
+
  private:
   static_assert(sizeof(page_id_t) == 4);
 
@@ -167,10 +198,6 @@ class TablePage : public Page {
   /** Set the number of tuples in this page. */
   void SetTupleCount(uint32_t tuple_count) { memcpy(GetData() + OFFSET_TUPLE_COUNT, &tuple_count, sizeof(uint32_t)); }
 
-  auto GetFreeSpaceRemaining() -> uint32_t {
-    return GetFreeSpacePointer() - SIZE_TABLE_PAGE_HEADER - SIZE_TUPLE * GetTupleCount();
-  }
-
   /** @return tuple offset at slot slot_num */
   auto GetTupleOffsetAtSlot(uint32_t slot_num) -> uint32_t {
     return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_OFFSET + SIZE_TUPLE * slot_num);
@@ -1,16 +1,17 @@
 #pragma once
 
+#include <cstring>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
-
 /**
+ * TmpTuplePage holds tuples that an executor spills out of memory, e.g. the partitions of a hash join whose build
+ * side exceeds the query memory budget. Tuples are only ever appended and read back, never updated or deleted.
+ *
  * TmpTuplePage format:
  *
  * Sizes are in bytes.
@@ -21,15 +22,47 @@ namespace bustub {
 class TmpTuplePage : public Page {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
-    memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    memcpy(GetData() + OFFSET_PAGE_ID, &page_id, sizeof(page_id_t));
+    SetFreeSpacePointer(page_size);
+  }
+
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_PAGE_ID); }
+
+  /** @return The offset of the most recently inserted tuple, or the page size if the page is empty */
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
+
+  /**
+   * Insert a tuple into the page.
+   * @param tuple the tuple to insert
+   * @param[out] out the location of the inserted tuple
+   * @return false if the page does not have enough room for the tuple
+   */
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    uint32_t free_space_pointer = GetFreeSpacePointer();
+    uint32_t needed = sizeof(uint32_t) + tuple.GetLength();
+    if (free_space_pointer < SIZE_TMP_TUPLE_PAGE_HEADER + needed) {
+      return false;
+    }
+    free_space_pointer -= needed;
+    tuple.SerializeTo(GetData() + free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer);
+    *out = TmpTuple(GetTablePageId(), free_space_pointer);
+    return true;
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  /** @brief Read the tuple at `tmp_tuple`, which must live on this page. */
+  void Get(const TmpTuple &tmp_tuple, Tuple *tuple) { tuple->DeserializeFrom(GetData() + tmp_tuple.GetOffset()); }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  static constexpr size_t SIZE_TMP_TUPLE_PAGE_HEADER = 12;
 
  private:
+  static constexpr size_t OFFSET_PAGE_ID = 0;
+  static constexpr size_t OFFSET_FREE_SPACE = 8;
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
+
   static_assert(sizeof(page_id_t) == 4);
 };
 
@@ -0,0 +1,92 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.h
+//
+// Identification: src/include/storage/table/free_space_map.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "storage/page/free_space_map_page.h"
+
+namespace bustub {
+
+/**
+ * FreeSpaceMap tracks the approximate free space of the pages of a table heap, so that an insert can go straight to a
+ * page with room instead of walking the page chain.
+ *
+ * The map lives in FreeSpaceMapPages, one byte per heap page. The heap updates the entry of a page whenever it inserts
+ * into it or reclaims space on it; an entry can still be stale for a moment, so a page the map offers may turn out to
+ * be full, in which case the heap corrects the entry and asks again.
+ *
+ * Every thread inserts into its own target page for as long as that has room, and only then looks for another one,
+ * preferring pages that are not the target of another thread. Concurrent inserts thus spread over different pages
+ * instead of queueing on the latch of the same one.
+ *
+ * The map is not persisted: the map pages belong to the FreeSpaceMap object and are deleted when it is destroyed.
+ */
+class FreeSpaceMap {
+ public:
+  /** The number of target pages; threads share a target if their ids hash to the same one. */
+  static constexpr size_t TARGET_SLOTS = 16;
+
+  explicit FreeSpaceMap(BufferPoolManager *buffer_pool_manager) : buffer_pool_manager_(buffer_pool_manager) {
+    targets_.fill(INVALID_PAGE_ID);
+  }
+
+  /** The map is rebuilt whenever its table is opened, so its pages are deleted with it. */
+  ~FreeSpaceMap();
+
+  /**
+   * @brief Record the free space of a heap page, adding the page to the map if it is new.
+   * @param heap_page_id the heap page
+   * @param free_bytes the bytes free on the page
+   */
+  void Update(page_id_t heap_page_id, uint32_t free_bytes);
+
+  /** @brief Forget a heap page, e.g. one that is being emptied or released. */
+  void Remove(page_id_t heap_page_id);
+
+  /**
+   * @brief Find a page for an insert, starting with the target page of the calling thread.
+   * @param bytes the bytes needed on the page
+   * @return a page that should have `bytes` free, or INVALID_PAGE_ID if no page has
+   */
+  auto FindPage(uint32_t bytes) -> page_id_t;
+
+  /** @return the number of heap pages in the map */
+  auto PageCount() -> size_t;
+
+ private:
+  /** @return the map page with the entry of `slot` pinned, nullptr if the buffer pool is out of frames */
+  auto FetchMapPage(size_t slot) -> FreeSpaceMapPage *;
+
+  /** @return the category recorded for the heap page, 0 if the page is not in the map */
+  auto CategoryOf(page_id_t heap_page_id) -> uint32_t;
+
+  /** @return true if the page is the target of a thread other than the one with the target `self` */
+  auto IsOtherTarget(page_id_t heap_page_id, const page_id_t &self) const -> bool;
+
+  BufferPoolManager *buffer_pool_manager_;
+  std::mutex latch_;
+  /** The map pages, in chain order. */
+  std::vector<page_id_t> map_pages_;
+  /** The slot of every heap page, the entry is on map page `slot / CAPACITY`. */
+  std::unordered_map<page_id_t, size_t> slots_;
+  size_t next_slot_{0};
+  std::array<page_id_t, TARGET_SLOTS> targets_;
+};
+
+}  // namespace bustub
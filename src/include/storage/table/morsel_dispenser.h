@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_dispenser.h
+//
+// Identification: src/include/storage/table/morsel_dispenser.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "common/config.h"
+#include "storage/table/table_heap.h"
+
+namespace bustub {
+
+/**
+ * MorselDispenser hands out the pages of a TableHeap to the workers of a parallel scan in morsels of a few pages.
+ *
+ * The page chain is a linked list, so claiming a morsel walks the next few links under a latch; reading the tuples of
+ * the claimed pages is then left to the worker. Workers that finish early simply claim more morsels, which balances
+ * the load without knowing the size of the table up front.
+ */
+class MorselDispenser {
+ public:
+  /** The number of pages in a morsel. */
+  static constexpr size_t PAGES_PER_MORSEL = 8;
+
+  explicit MorselDispenser(TableHeap *table_heap, size_t pages_per_morsel = PAGES_PER_MORSEL)
+      : table_heap_(table_heap), pages_per_morsel_(pages_per_morsel), next_page_id_(table_heap->GetFirstPageId()) {}
+
+  /**
+   * @brief Claim the next morsel.
+   * @param[out] pages Replaced with the ids of the claimed pages, in chain order
+   * @return false if every page has been handed out
+   */
+  auto Next(std::vector<page_id_t> *pages) -> bool;
+
+  /** @brief Start handing out the pages from the first page of the table again. */
+  void Reset();
+
+ private:
+  TableHeap *table_heap_;
+  size_t pages_per_morsel_;
+  std::mutex latch_;
+  /** The first page of the next morsel, INVALID_PAGE_ID once the chain is exhausted. */
+  page_id_t next_page_id_;
+};
+
+}  // namespace bustub
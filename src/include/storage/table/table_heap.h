@@ -12,10 +12,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
+#include "storage/table/free_space_map.h"
 #include "storage/table/table_iterator.h"
+#include "storage/table/table_page_guard.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -28,6 +35,21 @@ class TableHeap {
   friend class TableIterator;
 
  public:
+  /** What a Vacuum() did. */
+  struct VacuumStats {
+    /** Pages whose tuples were packed together. */
+    size_t compacted_pages_{0};
+    /** Bytes that compacting made free again. */
+    size_t reclaimed_bytes_{0};
+    /** Tuples moved off sparse pages. */
+    size_t moved_tuples_{0};
+    /** Emptied pages that were taken out of the chain and deleted. */
+    size_t released_pages_{0};
+  };
+
+  /** Called for every tuple that Vacuum() moves, with its old and new rid. */
+  using TupleMoveCallback = std::function<void(const Tuple &tuple, const RID &old_rid, const RID &new_rid)>;
+
   ~TableHeap() = default;
 
   /**
@@ -52,6 +74,7 @@ class TableHeap {
 
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * The tuple goes into a page that the free space map says has room, or into a new page at the end of the table.
    * @param tuple tuple to insert
    * @param[out] rid the rid of the inserted tuple
    * @param txn the transaction performing the insert
@@ -59,6 +82,18 @@ class TableHeap {
    */
   auto InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool;
 
+  /**
+   * Append a batch of tuples to the end of the table. Unlike InsertTuple() this does not ask the free space map for
+   * pages before the last one: it fills the last page and then fresh pages, fetching and latching each page once for
+   * all the tuples that go into it. If a tuple is too large for a page, nothing is inserted. If the buffer pool runs
+   * out of pages partway, the tuples inserted so far are left in the transaction's write set for the abort to undo.
+   * @param tuples tuples to insert
+   * @param[out] rids the rids of the inserted tuples, one per tuple inserted
+   * @param txn the transaction performing the insert
+   * @return true iff the insert is successful
+   */
+  auto InsertTuples(const std::vector<Tuple> &tuples, std::vector<RID> *rids, Transaction *txn) -> bool;
+
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
    * @param rid resource id of the tuple of delete
@@ -99,6 +134,40 @@ class TableHeap {
    */
   auto GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool acquire_read_lock = true) -> bool;
 
+  /**
+   * Pin a page of the table for reading its tuples in place.
+   * @param page_id id of a page of this table
+   * @return the guard that unpins the page when it goes away
+   */
+  auto PinPage(page_id_t page_id) -> TablePageGuard;
+
+  /**
+   * Read a batch of tuples, fetching and latching each page once for a run of rids on the same page.
+   * @param rids rids of the tuples to read, best sorted by page
+   * @param txn transaction performing the read
+   * @param[out] tuples the tuples, one per rid
+   * @param[out] found whether each tuple exists
+   */
+  void GetTuples(const std::vector<RID> &rids, Transaction *txn, std::vector<Tuple> *tuples, std::vector<bool> *found);
+
+  /**
+   * Reclaim the space of deleted tuples. Every page with dead space is compacted, and the live tuples of pages that
+   * are mostly empty are moved to other pages, after which the emptied pages leave the chain and are deleted.
+   *
+   * A moved tuple gets a new rid, which `on_move` is told about, e.g. to fix the indexes of the table. Vacuum must not
+   * run concurrently with other readers or writers of the table. Pages with deletes that are not yet applied, and pages
+   * whose rids are in the write sets of running transactions, are only compacted.
+   * @param txn the transaction performing the vacuum
+   * @param busy_pages the pages with tuples that running transactions wrote
+   * @param on_move called for every moved tuple
+   * @return what the vacuum did
+   */
+  auto Vacuum(Transaction *txn, const std::unordered_set<page_id_t> &busy_pages, const TupleMoveCallback &on_move)
+      -> VacuumStats;
+
+  /** @return the id of the page after `page_id` in the page chain, INVALID_PAGE_ID for the last page */
+  auto GetNextPageId(page_id_t page_id) -> page_id_t;
+
   /** @return the begin iterator of this table */
   auto Begin(Transaction *txn) -> TableIterator;
 
@@ -108,11 +177,44 @@ class TableHeap {
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
+  /** @return the free space map of this table */
+  inline auto GetFreeSpaceMap() -> FreeSpaceMap * { return &free_space_map_; }
+
  private:
+  /** @return the last page of the chain, pinned and write latched, or nullptr if it could not be fetched */
+  auto LatchLastPage() -> TablePage *;
+
+  /**
+   * Append a new page to the chain and release the old last page.
+   * @param last_page the write latched last page
+   * @param txn the transaction performing the insert
+   * @return the new page, pinned and write latched, or nullptr if the buffer pool is out of pages
+   */
+  auto AppendPage(TablePage *last_page, Transaction *txn) -> TablePage *;
+
+  /** Insert a tuple like InsertTuple() does, but without recording it in the write set of the transaction. */
+  auto PlaceTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool;
+
+  /**
+   * Move the live tuples of a page to other pages of the table. The page stays write latched throughout, so no update
+   * can come in between the copy of a tuple and its delete.
+   * @return true if the page is empty now
+   */
+  auto EmptyPage(page_id_t page_id, Transaction *txn, const TupleMoveCallback &on_move, VacuumStats *stats) -> bool;
+
+  /**
+   * Take an empty page out of the chain and delete it. The page must be neither the first nor the last page.
+   * @return false if the page was kept, because it has a tuple again or someone else has it pinned
+   */
+  auto ReleasePage(page_id_t page_id) -> bool;
+
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+  /** A page at or before the end of the page chain, where appends start looking for the last page. */
+  std::atomic<page_id_t> last_page_id_{INVALID_PAGE_ID};
+  FreeSpaceMap free_space_map_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_page_guard.h
+//
+// Identification: src/include/storage/table/table_page_guard.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+/**
+ * TablePageGuard keeps a page of a table heap pinned in the buffer pool for as long as it lives, which is what keeps
+ * the TupleViews into the page valid. The guard does not latch the page; readers latch it around reading views.
+ */
+class TablePageGuard {
+ public:
+  TablePageGuard() = default;
+
+  /** Take over the pin of a page fetched from `bpm`. */
+  TablePageGuard(BufferPoolManager *bpm, TablePage *page) : bpm_(bpm), page_(page) {}
+
+  TablePageGuard(const TablePageGuard &) = delete;
+  auto operator=(const TablePageGuard &) -> TablePageGuard & = delete;
+
+  TablePageGuard(TablePageGuard &&other) noexcept : bpm_(other.bpm_), page_(std::exchange(other.page_, nullptr)) {}
+
+  auto operator=(TablePageGuard &&other) noexcept -> TablePageGuard & {
+    if (this != &other) {
+      Release();
+      bpm_ = other.bpm_;
+      page_ = std::exchange(other.page_, nullptr);
+    }
+    return *this;
+  }
+
+  ~TablePageGuard() { Release(); }
+
+  /** @return true if the guard holds a page */
+  auto IsValid() const -> bool { return page_ != nullptr; }
+
+  auto GetPage() const -> TablePage * { return page_; }
+
+  /** @brief Unpin the page early. Views into it must not be used afterwards. */
+  void Release() {
+    if (page_ != nullptr) {
+      bpm_->UnpinPage(page_->GetTablePageId(), false);
+      page_ = nullptr;
+    }
+  }
+
+ private:
+  BufferPoolManager *bpm_{nullptr};
+  TablePage *page_{nullptr};
+};
+
+}  // namespace bustub
@@ -4,8 +4,10 @@
 
 namespace bustub {
 
-// Document this class! What does it represent?
-
+/**
+ * TmpTuple is the location of a tuple that was spilled to a TmpTuplePage: the page and the byte offset of the tuple
+ * within it.
+ */
 class TmpTuple {
  public:
   TmpTuple(page_id_t page_id, size_t offset) : page_id_(page_id), offset_(offset) {}
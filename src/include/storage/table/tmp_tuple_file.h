@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.h
+//
+// Identification: src/include/storage/table/tmp_tuple_file.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleFile is an append-only sequence of tuples stored on TmpTuplePages through the buffer pool. Executors use it
+ * to spill intermediate results that do not fit into the query memory budget.
+ *
+ * Only the page being appended to and the page being read are pinned. Reading returns the tuples in the order they
+ * were appended and may start once writing is finished. All pages are deleted when the file is destroyed.
+ */
+class TmpTupleFile {
+ public:
+  explicit TmpTupleFile(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  ~TmpTupleFile();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleFile);
+
+  /**
+   * @brief Append a tuple to the end of the file.
+   * @throws ExecutionException if the buffer pool has no frame left for a new page, or the tuple does not fit a page
+   */
+  void Append(const Tuple &tuple);
+
+  /** @brief Finish writing and unpin the last page. Further appends start a new page. */
+  void FinishWrite();
+
+  /** @brief Start reading from the first tuple. */
+  void Rewind();
+
+  /**
+   * @brief Read the next tuple.
+   * @return false if all tuples have been read
+   */
+  auto Next(Tuple *tuple) -> bool;
+
+  /** @return The number of tuples in the file */
+  auto Size() const -> size_t { return num_tuples_; }
+
+  /** @return The number of tuple bytes in the file */
+  auto Bytes() const -> size_t { return num_bytes_; }
+
+  /** @return The number of pages in the file */
+  auto NumPages() const -> size_t { return pages_.size(); }
+
+ private:
+  /** @brief Pin the page at `read_page_idx_` and collect the offsets of its tuples in insertion order. */
+  void LoadReadPage();
+
+  void ReleaseReadPage();
+
+  BufferPoolManager *bpm_;
+  std::vector<page_id_t> pages_;
+  size_t num_tuples_{0};
+  size_t num_bytes_{0};
+
+  /** The pinned last page while writing, nullptr otherwise. */
+  TmpTuplePage *write_page_{nullptr};
+
+  /** The pinned page being read and the offsets of its tuples, the last inserted tuple first. */
+  TmpTuplePage *read_page_{nullptr};
+  size_t read_page_idx_{0};
+  std::vector<uint32_t> read_offsets_;
+};
+
+}  // namespace bustub
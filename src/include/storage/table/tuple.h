@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/arena.h"
 #include "common/rid.h"
 #include "type/value.h"
 
@@ -31,6 +32,7 @@ class Tuple {
   friend class TablePage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class TupleView;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -45,9 +47,18 @@ class Tuple {
   // copy constructor, deep copy
   Tuple(const Tuple &other);
 
-  // assign operator, deep copy
+  // move constructor, takes over the data buffer
+  Tuple(Tuple &&other) noexcept;
+
+  // copy constructor into an arena, the copy does not own its data, which lives as long as the arena
+  Tuple(const Tuple &other, Arena *arena);
+
+  // assign operator, deep copy (reuses the buffer if the length matches)
   auto operator=(const Tuple &other) -> Tuple &;
 
+  // move assign operator, takes over the data buffer
+  auto operator=(Tuple &&other) noexcept -> Tuple &;
+
   ~Tuple() {
     if (allocated_) {
       delete[] data_;
@@ -74,8 +85,14 @@ class Tuple {
   // checks the schema to see how to return the Value.
   auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
 
+  // Concatenate two tuples into a tuple of the columns of `left_schema` followed by those of `right_schema`, copying
+  // their bytes instead of their values
+  static auto Concat(const Tuple &left, const Schema &left_schema, const Tuple &right, const Schema &right_schema)
+      -> Tuple;
+
   // Generates a key tuple given schemas and attributes
-  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) -> Tuple;
+  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
+      -> Tuple;
 
   // Is the column value null ?
   inline auto IsNull(const Schema *schema, uint32_t column_idx) const -> bool {
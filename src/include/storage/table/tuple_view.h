@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_view.h
+//
+// Identification: src/include/storage/table/tuple_view.h
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TupleView is a tuple read in place from a table page, without copying its bytes.
+ *
+ * A view is valid while its page stays pinned (see TablePageGuard) and unchanged, i.e. while the page is latched.
+ * Operators that keep a tuple beyond that, like sort buffers or hash join builds, copy it out with Materialize().
+ */
+class TupleView {
+ public:
+  TupleView() = default;
+
+  TupleView(RID rid, const char *data, uint32_t size) {
+    tuple_.rid_ = rid;
+    tuple_.size_ = size;
+    tuple_.data_ = const_cast<char *>(data);  // NOLINT
+  }
+
+  inline auto GetRid() const -> RID { return tuple_.rid_; }
+
+  inline auto GetData() const -> const char * { return tuple_.data_; }
+
+  inline auto GetLength() const -> uint32_t { return tuple_.size_; }
+
+  inline auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value {
+    return tuple_.GetValue(schema, column_idx);
+  }
+
+  /**
+   * @return The viewed bytes as a Tuple, for evaluating expressions on them. The tuple does not own its data; a copy
+   * of it shares the bytes in the page, so it must not outlive the view either.
+   */
+  inline auto AsTuple() const -> const Tuple & { return tuple_; }
+
+  /** @brief Copy the tuple into `tuple`, reusing its buffer if it has the same length. */
+  void MaterializeInto(Tuple *tuple) const {
+    if (!tuple->allocated_ || tuple->size_ != tuple_.size_) {
+      if (tuple->allocated_) {
+        delete[] tuple->data_;
+      }
+      tuple->data_ = new char[tuple_.size_];
+      tuple->size_ = tuple_.size_;
+      tuple->allocated_ = true;
+    }
+    memcpy(tuple->data_, tuple_.data_, tuple_.size_);
+    tuple->rid_ = tuple_.rid_;
+  }
+
+  /** @return An owning copy of the tuple */
+  auto Materialize() const -> Tuple {
+    Tuple tuple;
+    MaterializeInto(&tuple);
+    return tuple;
+  }
+
+ private:
+  /** A tuple that does not own its data and points into the page. */
+  Tuple tuple_;
+};
+
+}  // namespace bustub
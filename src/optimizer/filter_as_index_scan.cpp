@@ -0,0 +1,64 @@
+#include <memory>
+#include <optional>
+#include <tuple>
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+#include "type/type_id.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeFilterAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeFilterAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::Filter) {
+    return optimized_plan;
+  }
+  const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+  BUSTUB_ENSURE(filter_plan.children_.size() == 1, "Filter should have exactly 1 child.");
+  const auto &child_plan = filter_plan.children_[0];
+  if (child_plan->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
+  if (seq_scan.filter_predicate_ != nullptr) {
+    return optimized_plan;
+  }
+
+  // Match `column = constant` or `constant = column`.
+  const auto *expr = dynamic_cast<const ComparisonExpression *>(filter_plan.GetPredicate().get());
+  if (expr == nullptr || expr->comp_type_ != ComparisonType::Equal) {
+    return optimized_plan;
+  }
+  const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
+  auto constant_expr = expr->children_[1];
+  if (column_expr == nullptr) {
+    column_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
+    constant_expr = expr->children_[0];
+  }
+  if (column_expr == nullptr || dynamic_cast<const ConstantValueExpression *>(constant_expr.get()) == nullptr) {
+    return optimized_plan;
+  }
+  // Index keys are built straight from the constant, so the types must agree.
+  if (constant_expr->GetReturnType() != column_expr->GetReturnType()) {
+    return optimized_plan;
+  }
+
+  if (auto index = MatchIndex(seq_scan.table_name_, column_expr->GetColIdx()); index != std::nullopt) {
+    auto [index_oid, index_name] = *index;
+    return std::make_shared<IndexScanPlanNode>(filter_plan.output_schema_, index_oid, constant_expr);
+  }
+  return optimized_plan;
+}
+
+}  // namespace bustub
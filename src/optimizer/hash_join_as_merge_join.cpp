@@ -0,0 +1,81 @@
+#include <memory>
+
+#include "binder/bound_order_by.h"
+#include "catalog/catalog.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::IsOrderedOn(const AbstractPlanNode &plan, uint32_t col_idx) -> bool {
+  switch (plan.GetType()) {
+    case PlanType::Sort: {
+      const auto &order_bys = dynamic_cast<const SortPlanNode &>(plan).GetOrderBy();
+      const auto &[order_type, expr] = order_bys[0];
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      return (order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT) && column_value_expr != nullptr &&
+             column_value_expr->GetColIdx() == col_idx;
+    }
+    case PlanType::IndexScan: {
+      // Both a full scan and a point lookup of a B+ tree come out in key order.
+      const auto *index_info = catalog_.GetIndex(dynamic_cast<const IndexScanPlanNode &>(plan).GetIndexOid());
+      const auto &key_attrs = index_info->index_->GetKeyAttrs();
+      return index_info->index_type_ == IndexType::BPlusTreeIndex && key_attrs.size() == 1 && key_attrs[0] == col_idx;
+    }
+    case PlanType::Filter:
+    case PlanType::Limit:
+      return IsOrderedOn(*plan.GetChildAt(0), col_idx);
+    case PlanType::Projection: {
+      const auto &expr = dynamic_cast<const ProjectionPlanNode &>(plan).GetExpressions()[col_idx];
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      return column_value_expr != nullptr && IsOrderedOn(*plan.GetChildAt(0), column_value_expr->GetColIdx());
+    }
+    case PlanType::MergeJoin: {
+      // The output follows the left key; in an inner join the right key has the same value in every row.
+      const auto &merge_join = dynamic_cast<const MergeJoinPlanNode &>(plan);
+      const auto left_columns = merge_join.GetLeftPlan()->OutputSchema().GetColumnCount();
+      const auto *left_key = dynamic_cast<const ColumnValueExpression *>(&merge_join.LeftJoinKeyExpression());
+      const auto *right_key = dynamic_cast<const ColumnValueExpression *>(&merge_join.RightJoinKeyExpression());
+      if (left_key != nullptr && left_key->GetColIdx() == col_idx) {
+        return true;
+      }
+      return merge_join.GetJoinType() == JoinType::INNER && right_key != nullptr &&
+             right_key->GetColIdx() + left_columns == col_idx;
+    }
+    default:
+      return false;
+  }
+}
+
+auto Optimizer::OptimizeHashJoinAsMergeJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeHashJoinAsMergeJoin(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::HashJoin) {
+    const auto &hash_join = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+    const auto *left_key = dynamic_cast<const ColumnValueExpression *>(&hash_join.LeftJoinKeyExpression());
+    const auto *right_key = dynamic_cast<const ColumnValueExpression *>(&hash_join.RightJoinKeyExpression());
+    // Only worth it if both sides come in key order anyway; sorting an input just to merge it is not.
+    if (left_key != nullptr && right_key != nullptr && IsOrderedOn(*hash_join.GetLeftPlan(), left_key->GetColIdx()) &&
+        IsOrderedOn(*hash_join.GetRightPlan(), right_key->GetColIdx())) {
+      return std::make_shared<MergeJoinPlanNode>(hash_join.output_schema_, hash_join.GetLeftPlan(),
+                                                 hash_join.GetRightPlan(), hash_join.left_key_expression_,
+                                                 hash_join.right_key_expression_, hash_join.GetJoinType());
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
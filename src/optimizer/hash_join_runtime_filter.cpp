@@ -0,0 +1,89 @@
+#include <memory>
+#include <vector>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+auto IsIntegerType(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+/**
+ * @return the plan with runtime filter `id` set on the sequential scan that produces column `col_idx` of it, or
+ * nullptr if the column does not come straight from a scan through filters and projections. Nothing else may lie in
+ * between: dropping input tuples of e.g. a limit or an aggregation would change its output.
+ */
+auto AttachToProbeScan(const AbstractPlanNodeRef &plan, uint32_t col_idx, size_t id) -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    case PlanType::Filter: {
+      auto child = AttachToProbeScan(plan->GetChildAt(0), col_idx, id);
+      return child == nullptr ? nullptr : AbstractPlanNodeRef(plan->CloneWithChildren({child}));
+    }
+    case PlanType::Projection: {
+      const auto &expr = dynamic_cast<const ProjectionPlanNode &>(*plan).GetExpressions()[col_idx];
+      const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+      if (column_value_expr == nullptr) {
+        return nullptr;
+      }
+      auto child = AttachToProbeScan(plan->GetChildAt(0), column_value_expr->GetColIdx(), id);
+      return child == nullptr ? nullptr : AbstractPlanNodeRef(plan->CloneWithChildren({child}));
+    }
+    case PlanType::SeqScan: {
+      const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*plan);
+      if (seq_scan.runtime_filter_.has_value() || seq_scan.limit_.has_value() ||
+          !IsIntegerType(seq_scan.OutputSchema().GetColumn(col_idx).GetType())) {
+        return nullptr;
+      }
+      auto annotated = std::make_shared<SeqScanPlanNode>(seq_scan);
+      annotated->runtime_filter_ = id;
+      annotated->runtime_filter_column_ = col_idx;
+      return annotated;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+auto AddRuntimeFilters(const AbstractPlanNodeRef &plan, size_t *next_id) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(AddRuntimeFilters(child, next_id));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() != PlanType::HashJoin) {
+    return optimized_plan;
+  }
+  const auto &hash_join = dynamic_cast<const HashJoinPlanNode &>(*optimized_plan);
+  const auto *left_key = dynamic_cast<const ColumnValueExpression *>(&hash_join.LeftJoinKeyExpression());
+  // A LEFT join emits every probe tuple, so only an inner join may drop the ones without a match.
+  if (hash_join.GetJoinType() != JoinType::INNER || left_key == nullptr ||
+      !IsIntegerType(hash_join.RightJoinKeyExpression().GetReturnType())) {
+    return optimized_plan;
+  }
+  auto probe = AttachToProbeScan(hash_join.GetLeftPlan(), left_key->GetColIdx(), *next_id);
+  if (probe == nullptr) {
+    return optimized_plan;
+  }
+  auto annotated = std::make_shared<HashJoinPlanNode>(hash_join);
+  annotated->children_[0] = probe;
+  annotated->runtime_filter_ = (*next_id)++;
+  return annotated;
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeHashJoinRuntimeFilter(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  size_t next_id = 0;
+  return AddRuntimeFilters(plan, &next_id);
+}
+
+}  // namespace bustub
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/limit_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/topn_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/**
+ * @return the plan with `limit` set on the scan at the bottom of it, or nullptr if the plan is not a scan under a chain
+ * of projections. A projection emits one tuple per input tuple, so the first `limit` tuples of the scan are all the
+ * limit above needs.
+ */
+auto PushLimitIntoScan(const AbstractPlanNodeRef &plan, size_t limit) -> AbstractPlanNodeRef {
+  switch (plan->GetType()) {
+    case PlanType::Projection: {
+      auto child = PushLimitIntoScan(plan->GetChildAt(0), limit);
+      return child == nullptr ? nullptr : AbstractPlanNodeRef(plan->CloneWithChildren({child}));
+    }
+    case PlanType::SeqScan: {
+      auto seq_scan = std::make_shared<SeqScanPlanNode>(dynamic_cast<const SeqScanPlanNode &>(*plan));
+      seq_scan->limit_ = std::min(seq_scan->limit_.value_or(limit), limit);
+      return seq_scan;
+    }
+    case PlanType::IndexScan: {
+      auto index_scan = std::make_shared<IndexScanPlanNode>(dynamic_cast<const IndexScanPlanNode &>(*plan));
+      index_scan->limit_ = std::min(index_scan->limit_.value_or(limit), limit);
+      return index_scan;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeOrderedTopNAsLimit(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeOrderedTopNAsLimit(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::TopN) {
+    const auto &topn = dynamic_cast<const TopNPlanNode &>(*optimized_plan);
+    const auto &order_bys = topn.GetOrderBy();
+    if (order_bys.size() != 1) {
+      return optimized_plan;
+    }
+    const auto &[order_type, expr] = order_bys[0];
+    const auto *column_value_expr = dynamic_cast<const ColumnValueExpression *>(expr.get());
+    // Ties keep their input order in a TopN as well, so the first N input tuples are exactly its output.
+    if ((order_type == OrderByType::ASC || order_type == OrderByType::DEFAULT) && column_value_expr != nullptr &&
+        IsOrderedOn(*topn.GetChildPlan(), column_value_expr->GetColIdx())) {
+      return std::make_shared<LimitPlanNode>(topn.output_schema_, topn.GetChildPlan(), topn.GetN());
+    }
+  }
+
+  return optimized_plan;
+}
+
+auto Optimizer::OptimizeLimitPushdown(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeLimitPushdown(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  if (optimized_plan->GetType() == PlanType::Limit) {
+    const auto &limit_plan = dynamic_cast<const LimitPlanNode &>(*optimized_plan);
+    // The limit stays on top: a parallel scan stops each of its workers at the limit, not the scan as a whole.
+    if (auto child = PushLimitIntoScan(limit_plan.GetChildPlan(), limit_plan.GetLimit()); child != nullptr) {
+      return optimized_plan->CloneWithChildren({child});
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -60,7 +60,9 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
             // Ensure right child is table scan
             if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan) {
               const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
-              if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
+              // The index lookup would drop a predicate merged into the scan.
+              if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1 &&
+                  right_seq_scan.filter_predicate_ == nullptr) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, right_expr->GetColIdx());
                     index != std::nullopt) {
                   auto [index_oid, index_name] = *index;
@@ -70,7 +72,8 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
                       right_seq_scan.output_schema_, nlj_plan.GetJoinType());
                 }
               }
-              if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0) {
+              if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0 &&
+                  right_seq_scan.filter_predicate_ == nullptr) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, left_expr->GetColIdx());
                     index != std::nullopt) {
                   auto [index_oid, index_name] = *index;
@@ -12,9 +12,16 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
   p = OptimizeNLJAsIndexJoin(p);
-  // p = OptimizeNLJAsHashJoin(p);  // Enable this rule after you have implemented hash join.
+  p = OptimizeFilterAsIndexScan(p);
+  p = OptimizeNLJAsHashJoin(p);
   p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeHashJoinAsMergeJoin(p);
+  p = OptimizeMergeFilterScan(p);
   p = OptimizeSortLimitAsTopN(p);
+  p = OptimizeOrderedTopNAsLimit(p);
+  p = OptimizeLimitPushdown(p);
+  p = OptimizeHashJoinRuntimeFilter(p);
+  p = OptimizeParallelScan(p);
   return p;
 }
 
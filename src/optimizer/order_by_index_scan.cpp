@@ -55,14 +55,16 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
     BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Sort with multiple children?? Impossible!");
     const auto &child_plan = optimized_plan->children_[0];
 
-    if (child_plan->GetType() == PlanType::SeqScan) {
+    if (child_plan->GetType() == PlanType::SeqScan &&
+        dynamic_cast<const SeqScanPlanNode &>(*child_plan).filter_predicate_ == nullptr) {
       const auto &seq_scan = dynamic_cast<const SeqScanPlanNode &>(*child_plan);
       const auto *table_info = catalog_.GetTable(seq_scan.GetTableOid());
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
       for (const auto *index : indices) {
         const auto &columns = index->key_schema_.GetColumns();
-        if (columns.size() == 1 &&
+        // Only the B+ tree can hand out tuples in key order.
+        if (index->index_type_ == IndexType::BPlusTreeIndex && columns.size() == 1 &&
             columns[0].GetName() == table_info->schema_.GetColumn(order_by_column_id).GetName()) {
           // Index matched, return index scan instead
           return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index->index_oid_);
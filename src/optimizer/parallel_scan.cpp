@@ -0,0 +1,49 @@
+#include <memory>
+#include <vector>
+
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/gather_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+namespace {
+
+/** @return true if the plan is a sequential scan, possibly under a chain of filters and projections */
+auto IsScanPipeline(const AbstractPlanNode &plan) -> bool {
+  switch (plan.GetType()) {
+    case PlanType::SeqScan:
+      return true;
+    case PlanType::Filter:
+    case PlanType::Projection:
+      return IsScanPipeline(*plan.GetChildAt(0));
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+auto Optimizer::OptimizeParallelScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  if (scan_threads_ <= 1) {
+    return plan;
+  }
+  // DML keeps a serial scan: its input must not interleave with its own writes to the same table.
+  if (plan->GetType() == PlanType::Insert || plan->GetType() == PlanType::Update ||
+      plan->GetType() == PlanType::Delete) {
+    return plan;
+  }
+  if (IsScanPipeline(*plan)) {
+    return std::make_shared<GatherPlanNode>(plan->output_schema_, plan, scan_threads_);
+  }
+
+  // Every child is scanned once per Init(), the inner side of a nested loop join too: the join buffers it in memory
+  // and runs each block of outer tuples against the buffer.
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeParallelScan(child));
+  }
+  return plan->CloneWithChildren(std::move(children));
+}
+
+}  // namespace bustub
@@ -0,0 +1,50 @@
+#include <vector>
+
+#include "storage/index/art_index.h"
+#include "storage/index/generic_key.h"
+#include "storage/index/normalized_key.h"
+
+namespace bustub {
+/*
+ * Constructor
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+ART_INDEX_TYPE::ArtIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
+    : Index(std::move(metadata)) {}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::EncodeKey(const Tuple &key, std::vector<uint8_t> *normalized) const {
+  // Go through the fixed-size index key, so that the tree sees exactly what the other indexes compare.
+  KeyType index_key;
+  index_key.SetFromKey(key);
+  NormalizedKey::FromGenericKey(index_key, GetKeySchema(), normalized);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  std::vector<uint8_t> normalized;
+  EncodeKey(key, &normalized);
+  container_.Insert(normalized.data(), normalized.size(), rid);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  std::vector<uint8_t> normalized;
+  EncodeKey(key, &normalized);
+  container_.Remove(normalized.data(), normalized.size(), rid);
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void ART_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  std::vector<uint8_t> normalized;
+  EncodeKey(key, &normalized);
+  container_.GetValue(normalized.data(), normalized.size(), result);
+}
+
+template class ArtIndex<GenericKey<4>, RID, GenericComparator<4>>;
+template class ArtIndex<GenericKey<8>, RID, GenericComparator<8>>;
+template class ArtIndex<GenericKey<16>, RID, GenericComparator<16>>;
+template class ArtIndex<GenericKey<32>, RID, GenericComparator<32>>;
+template class ArtIndex<GenericKey<64>, RID, GenericComparator<64>>;
+
+}  // namespace bustub
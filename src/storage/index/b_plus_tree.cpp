@@ -15,9 +15,7 @@ BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manag
       buffer_pool_manager_(buffer_pool_manager),
       comparator_(comparator),
       leaf_max_size_(leaf_max_size),
-      internal_max_size_(internal_max_size) {
-  std::cout << leaf_max_size << " " << internal_max_size << std::endl;
-}
+      internal_max_size_(internal_max_size) {}
 
 /*
  * Helper function to decide whether current b+tree is empty
@@ -80,6 +78,7 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
   root_latch_.RLock();
   root_latch_.RLock();
   if (IsEmpty()) {
+    root_latch_.RUnlock();
     root_latch_.RUnlock();
     return false;
   }
@@ -98,6 +97,56 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
   return ret;
 }
 
+/*
+ * Look up a batch of keys, preferably sorted in ascending order. The leaf of the last lookup stays latched, and the
+ * next key is searched in it directly if it lies within the keys of the leaf; keys are unique, so the key cannot be in
+ * any other leaf then.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::GetValues(const std::vector<KeyType> &keys, std::vector<std::pair<size_t, ValueType>> *result,
+                               Transaction *transaction) {
+  root_latch_.RLock();
+  if (IsEmpty()) {
+    root_latch_.RUnlock();
+    return;
+  }
+  Page *page = nullptr;
+  LeafPage *leaf_page = nullptr;
+  for (size_t i = 0; i < keys.size(); i++) {
+    const auto &key = keys[i];
+    bool in_leaf = leaf_page != nullptr && leaf_page->GetSize() > 0 && comparator_(leaf_page->KeyAt(0), key) <= 0 &&
+                   comparator_(key, leaf_page->KeyAt(leaf_page->GetSize() - 1)) <= 0;
+    if (!in_leaf) {
+      if (page != nullptr) {
+        page->RUnlatch();
+        buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      }
+      // GetLeafPage releases one read latch on the root once it latched the root page.
+      root_latch_.RLock();
+      page = GetLeafPage(key, Operation::Read, transaction);
+      leaf_page = reinterpret_cast<LeafPage *>(page->GetData());
+    }
+    int l = 0;
+    int r = leaf_page->GetSize();
+    while (l < r) {
+      int mid = (l + r) / 2;
+      if (comparator_(leaf_page->KeyAt(mid), key) < 0) {
+        l = mid + 1;
+      } else {
+        r = mid;
+      }
+    }
+    if (l < leaf_page->GetSize() && comparator_(leaf_page->KeyAt(l), key) == 0) {
+      result->emplace_back(i, leaf_page->ValueAt(l));
+    }
+  }
+  if (page != nullptr) {
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  }
+  root_latch_.RUnlock();
+}
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
@@ -110,7 +159,6 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) -> bool {
-  std::cout << "insert:" << key << std::endl;
   root_latch_.WLock();
   transaction->AddIntoPageSet(nullptr);
 
@@ -215,6 +263,80 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
   return true;
 }
 
+/*
+ * Insert a batch of key & value pairs, preferably sorted by key. The leaf of the last insert stays latched while it
+ * can take another key without splitting, and the next key is inserted into it directly if it falls into its range:
+ * between its first and last key, or anywhere above its first key if it is the rightmost leaf. Keys that need a split
+ * go through Insert(). Duplicate keys are skipped, as in Insert().
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::InsertBatch(const std::vector<KeyType> &keys, const std::vector<ValueType> &values,
+                                 Transaction *transaction) {
+  if (transaction == nullptr) {
+    // the latched leaf is kept in the page set of the transaction
+    for (size_t i = 0; i < keys.size(); i++) {
+      Insert(keys[i], values[i], transaction);
+    }
+    return;
+  }
+  LeafPage *leaf_page = nullptr;
+  for (size_t i = 0; i < keys.size(); i++) {
+    const auto &key = keys[i];
+    bool in_leaf = leaf_page != nullptr && leaf_page->GetSize() > 0 && comparator_(leaf_page->KeyAt(0), key) <= 0 &&
+                   (leaf_page->GetNextPageId() == INVALID_PAGE_ID ||
+                    comparator_(key, leaf_page->KeyAt(leaf_page->GetSize() - 1)) <= 0);
+    if (!in_leaf) {
+      if (leaf_page != nullptr) {
+        ReleaseWLatches(transaction);
+      }
+      leaf_page = LatchSafeLeaf(key, transaction);
+      if (leaf_page == nullptr) {
+        Insert(key, values[i], transaction);
+        continue;
+      }
+    }
+    int l = 0;
+    int r = leaf_page->GetSize();
+    while (l < r) {
+      int mid = (l + r) / 2;
+      if (comparator_(leaf_page->KeyAt(mid), key) < 0) {
+        l = mid + 1;
+      } else {
+        r = mid;
+      }
+    }
+    if (l < leaf_page->GetSize() && comparator_(leaf_page->KeyAt(l), key) == 0) {
+      continue;
+    }
+    leaf_page->Insert(key, values[i], comparator_);
+    if (!IsSafePage(leaf_page, Operation::Insert)) {
+      ReleaseWLatches(transaction);
+      leaf_page = nullptr;
+    }
+  }
+  if (leaf_page != nullptr) {
+    ReleaseWLatches(transaction);
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::LatchSafeLeaf(const KeyType &key, Transaction *transaction) -> LeafPage * {
+  root_latch_.WLock();
+  transaction->AddIntoPageSet(nullptr);
+  if (IsEmpty()) {
+    ReleaseWLatches(transaction);
+    return nullptr;
+  }
+  // GetLeafPage releases the root latch and the ancestors once it latched a safe page, so a safe leaf is the only
+  // page left in the page set.
+  auto leaf_page = reinterpret_cast<LeafPage *>(GetLeafPage(key, Operation::Insert, transaction)->GetData());
+  if (!IsSafePage(leaf_page, Operation::Insert)) {
+    ReleaseWLatches(transaction);
+    return nullptr;
+  }
+  return leaf_page;
+}
+
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
@@ -235,7 +357,6 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
     return;
   }
 
-  std::cout << "remove " << key << std::endl;
   // std::vector<ValueType> results;
   // if (!GetValue(key, &results, transaction)) {
   //   return;
@@ -286,7 +407,7 @@ void BPLUSTREE_TYPE::HandleUnderFlow(BPlusTreePage *page, Transaction *transacti
     tmp_page->WLatch();
     right_page = reinterpret_cast<InternalPage *>(tmp_page->GetData());
   } else if (left_sibling_id != INVALID_PAGE_ID) {
-    tmp_page = buffer_pool_manager_->FetchPage(right_sibling_id);
+    tmp_page = buffer_pool_manager_->FetchPage(left_sibling_id);
     tmp_page->WLatch();
     left_page = reinterpret_cast<InternalPage *>(tmp_page->GetData());
   }
@@ -472,7 +593,6 @@ void BPLUSTREE_TYPE::ReleaseWLatches(Transaction *transaction) {
   if (transaction == nullptr) {
     return;
   }
-  std::cout << "release:" << std::endl;
   auto page_set = transaction->GetPageSet();
   while (!page_set->empty()) {
     Page *page = page_set->front();
@@ -480,12 +600,10 @@ void BPLUSTREE_TYPE::ReleaseWLatches(Transaction *transaction) {
     if (page == nullptr) {
       root_latch_.WUnlock();
     } else {
-      std::cout << page->GetPageId() << " ";
       page->WUnlatch();
       buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
     }
   }
-  std::cout << std::endl;
 }
 /*****************************************************************************
  * INDEX ITERATOR
@@ -497,12 +615,17 @@ void BPLUSTREE_TYPE::ReleaseWLatches(Transaction *transaction) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
+  if (IsEmpty()) {
+    return End();
+  }
   page_id_t next_page_id = root_page_id_;
   while (true) {
     Page *page = buffer_pool_manager_->FetchPage(next_page_id);
     auto tree_page = reinterpret_cast<BPlusTreePage *>(page->GetData());
     if (tree_page->IsLeafPage()) {
-      return INDEXITERATOR_TYPE(tree_page->GetPageId(), buffer_pool_manager_, 0);
+      auto iterator = INDEXITERATOR_TYPE(tree_page->GetPageId(), buffer_pool_manager_, 0);
+      buffer_pool_manager_->UnpinPage(tree_page->GetPageId(), false);
+      return iterator;
     }
     auto internal_page = static_cast<InternalPage *>(tree_page);
     next_page_id = internal_page->ValueAt(0);
@@ -517,6 +640,10 @@ auto BPLUSTREE_TYPE::Begin() -> INDEXITERATOR_TYPE {
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE {
+  if (IsEmpty()) {
+    return End();
+  }
+  root_latch_.RLock();
   Page *page = GetLeafPage(key, Operation::Read, nullptr);
   auto leaf_page = reinterpret_cast<LeafPage *>(page->GetData());
   int index = 0;
@@ -526,7 +653,11 @@ auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE {
       break;
     }
   }
-  return INDEXITERATOR_TYPE(page->GetPageId(), buffer_pool_manager_, index);
+  // The iterator pins the leaf on its own, so the read path's latch and pin can go.
+  auto iterator = INDEXITERATOR_TYPE(page->GetPageId(), buffer_pool_manager_, index);
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  return iterator;
 }
 
 /*
@@ -11,6 +11,8 @@
 
 #include "storage/index/b_plus_tree_index.h"
 
+#include <algorithm>
+
 namespace bustub {
 /*
  * Constructor
@@ -29,6 +31,29 @@ void BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *t
   container_.Insert(index_key, rid, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::InsertEntries(const std::vector<Tuple> &keys, const std::vector<RID> &rids,
+                                        Transaction *transaction) {
+  std::vector<KeyType> index_keys(keys.size());
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+    order[i] = i;
+  }
+  // Stable, so that of two equal keys the first one is inserted and the second one rejected, as one at a time.
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t left, size_t right) { return comparator_(index_keys[left], index_keys[right]) < 0; });
+  std::vector<KeyType> sorted_keys;
+  std::vector<RID> sorted_rids;
+  sorted_keys.reserve(keys.size());
+  sorted_rids.reserve(keys.size());
+  for (auto i : order) {
+    sorted_keys.push_back(index_keys[i]);
+    sorted_rids.push_back(rids[i]);
+  }
+  container_.InsertBatch(sorted_keys, sorted_rids, transaction);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
@@ -47,6 +72,16 @@ void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, T
   container_.GetValue(index_key, result, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_INDEX_TYPE::ScanKeys(const std::vector<Tuple> &keys, std::vector<std::pair<size_t, RID>> *result,
+                                   Transaction *transaction) {
+  std::vector<KeyType> index_keys(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromKey(keys[i]);
+  }
+  container_.GetValues(index_keys, result, transaction);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetBeginIterator() -> INDEXITERATOR_TYPE { return container_.Begin(); }
 
@@ -16,8 +16,28 @@ INDEXITERATOR_TYPE::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int
   page_id_ = page_id;
   buffer_pool_manager_ = bpm;
   index_in_leaf_ = index_in_leaf;
+  if (page_id_ == INVALID_PAGE_ID) {
+    // The end iterator does not hold any page.
+    page_ = nullptr;
+    leaf_page_ = nullptr;
+    return;
+  }
   page_ = buffer_pool_manager_->FetchPage(page_id_);
   leaf_page_ = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(page_->GetData());
+  // Deletes can leave an empty leaf behind (e.g. the root); start at the first leaf that has an entry.
+  while (index_in_leaf_ >= leaf_page_->GetSize()) {
+    page_id_t prev_page_id = page_id_;
+    index_in_leaf_ = 0;
+    page_id_ = leaf_page_->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(prev_page_id, false);
+    if (page_id_ == INVALID_PAGE_ID) {
+      page_ = nullptr;
+      leaf_page_ = nullptr;
+      return;
+    }
+    page_ = buffer_pool_manager_->FetchPage(page_id_);
+    leaf_page_ = reinterpret_cast<B_PLUS_TREE_LEAF_PAGE_TYPE *>(page_->GetData());
+  }
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// normalized_key.cpp
+//
+// Identification: src/storage/index/normalized_key.cpp
+//
+// Copyright (c) 2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "common/exception.h"
+#include "storage/index/normalized_key.h"
+
+namespace bustub {
+
+namespace {
+
+/** Append the low `bytes` bytes of `bits` most significant byte first. */
+void AppendBigEndian(uint64_t bits, size_t bytes, std::vector<uint8_t> *out) {
+  for (size_t i = bytes; i > 0; i--) {
+    out->push_back(static_cast<uint8_t>(bits >> ((i - 1) * 8)));
+  }
+}
+
+/** Signed integers sort like unsigned ones once the sign bit is flipped. */
+template <typename T>
+void AppendSigned(T value, std::vector<uint8_t> *out) {
+  constexpr size_t bits = sizeof(T) * 8;
+  auto raw = static_cast<uint64_t>(static_cast<int64_t>(value));
+  raw ^= static_cast<uint64_t>(1) << (bits - 1);
+  AppendBigEndian(raw, sizeof(T), out);
+}
+
+}  // namespace
+
+void NormalizedKey::AppendValue(const Value &value, std::vector<uint8_t> *out) {
+  if (value.IsNull()) {
+    out->push_back(0);
+    return;
+  }
+  out->push_back(1);
+
+  switch (value.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      AppendSigned(value.GetAs<int8_t>(), out);
+      break;
+    case TypeId::SMALLINT:
+      AppendSigned(value.GetAs<int16_t>(), out);
+      break;
+    case TypeId::INTEGER:
+      AppendSigned(value.GetAs<int32_t>(), out);
+      break;
+    case TypeId::BIGINT:
+      AppendSigned(value.GetAs<int64_t>(), out);
+      break;
+    case TypeId::TIMESTAMP:
+      AppendBigEndian(value.GetAs<uint64_t>(), sizeof(uint64_t), out);
+      break;
+    case TypeId::DECIMAL: {
+      auto decimal = value.GetAs<double>();
+      uint64_t bits;
+      memcpy(&bits, &decimal, sizeof(bits));
+      const uint64_t sign = static_cast<uint64_t>(1) << 63;
+      bits = (bits & sign) != 0 ? ~bits : bits | sign;
+      AppendBigEndian(bits, sizeof(bits), out);
+      break;
+    }
+    case TypeId::VARCHAR: {
+      // The stored length counts the trailing '\0'.
+      const char *data = value.GetData();
+      uint32_t len = value.GetLength() - 1;
+      for (uint32_t i = 0; i < len; i++) {
+        auto byte = static_cast<uint8_t>(data[i]);
+        out->push_back(byte);
+        if (byte == 0) {
+          out->push_back(0xFF);
+        }
+      }
+      out->push_back(0);
+      out->push_back(0);
+      break;
+    }
+    default:
+      throw NotImplementedException("cannot normalize key of this type");
+  }
+}
+
+}  // namespace bustub
@@ -12,7 +12,9 @@
 
 #include "storage/page/table_page.h"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 namespace bustub {
 
@@ -326,6 +328,19 @@ auto TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
   return true;
 }
 
+auto TablePage::GetTupleView(const RID &rid, TupleView *view) -> bool {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount()) {
+    return false;
+  }
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  if (IsDeleted(tuple_size)) {
+    return false;
+  }
+  *view = TupleView(rid, GetData() + GetTupleOffsetAtSlot(slot_num), tuple_size);
+  return true;
+}
+
 auto TablePage::GetFirstTupleRid(RID *first_rid) -> bool {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
@@ -351,4 +366,55 @@ auto TablePage::GetNextTupleRid(const RID &cur_rid, RID *next_rid) -> bool {
   next_rid->Set(INVALID_PAGE_ID, 0);
   return false;
 }
+
+auto TablePage::GetDeadSpace() -> uint32_t {
+  uint32_t tuple_bytes = 0;
+  uint32_t used_slots = 0;
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    uint32_t tuple_size = UnsetDeletedFlag(GetTupleSize(i));
+    if (tuple_size != 0) {
+      tuple_bytes += tuple_size;
+      used_slots = i + 1;
+    }
+  }
+  return BUSTUB_PAGE_SIZE - GetFreeSpacePointer() - tuple_bytes + SIZE_TUPLE * (GetTupleCount() - used_slots);
+}
+
+auto TablePage::Compact() -> uint32_t {
+  uint32_t free_space_before = GetFreeSpaceRemaining();
+  std::vector<uint32_t> slots;
+  uint32_t used_slots = 0;
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    if (UnsetDeletedFlag(GetTupleSize(i)) != 0) {
+      slots.push_back(i);
+      used_slots = i + 1;
+    }
+  }
+  SetTupleCount(used_slots);
+
+  // Move the tuples from the end of the page on, each right in front of the one moved before it. A tuple thus never
+  // moves towards the header, and never over a tuple that is still to be moved.
+  std::sort(slots.begin(), slots.end(),
+            [this](uint32_t left, uint32_t right) { return GetTupleOffsetAtSlot(left) > GetTupleOffsetAtSlot(right); });
+  uint32_t free_space_pointer = BUSTUB_PAGE_SIZE;
+  for (auto slot : slots) {
+    uint32_t tuple_size = UnsetDeletedFlag(GetTupleSize(slot));
+    free_space_pointer -= tuple_size;
+    memmove(GetData() + free_space_pointer, GetData() + GetTupleOffsetAtSlot(slot), tuple_size);
+    SetTupleOffsetAtSlot(slot, free_space_pointer);
+  }
+  SetFreeSpacePointer(free_space_pointer);
+  return GetFreeSpaceRemaining() - free_space_before;
+}
+
+auto TablePage::HasPendingDeletes() -> bool {
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    uint32_t tuple_size = GetTupleSize(i);
+    if (tuple_size != 0 && IsDeleted(tuple_size)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace bustub
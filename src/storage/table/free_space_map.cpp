@@ -0,0 +1,159 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.cpp
+//
+// Identification: src/storage/table/free_space_map.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/free_space_map.h"
+
+#include <functional>
+#include <thread>  // NOLINT
+
+namespace bustub {
+
+FreeSpaceMap::~FreeSpaceMap() {
+  for (page_id_t map_page_id : map_pages_) {
+    buffer_pool_manager_->DeletePage(map_page_id);
+  }
+}
+
+void FreeSpaceMap::Update(page_id_t heap_page_id, uint32_t free_bytes) {
+  const uint8_t category = FreeSpaceMapPage::CategoryOf(free_bytes);
+  std::scoped_lock lock(latch_);
+  if (auto it = slots_.find(heap_page_id); it != slots_.end()) {
+    auto map_page = FetchMapPage(it->second);
+    if (map_page == nullptr) {
+      return;
+    }
+    map_page->SetCategory(it->second % FreeSpaceMapPage::CAPACITY, category);
+    buffer_pool_manager_->UnpinPage(map_page->GetPageId(), true);
+    return;
+  }
+
+  // A new heap page goes into the next slot, on a new map page if the last one is full.
+  if (next_slot_ % FreeSpaceMapPage::CAPACITY == 0) {
+    page_id_t map_page_id;
+    auto map_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->NewPage(&map_page_id));
+    if (map_page == nullptr) {
+      return;
+    }
+    map_page->Init(map_page_id);
+    buffer_pool_manager_->UnpinPage(map_page_id, true);
+    if (!map_pages_.empty()) {
+      auto prev_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(map_pages_.back()));
+      if (prev_page == nullptr) {
+        return;
+      }
+      prev_page->SetNextPageId(map_page_id);
+      buffer_pool_manager_->UnpinPage(map_pages_.back(), true);
+    }
+    map_pages_.push_back(map_page_id);
+  }
+  auto map_page = FetchMapPage(next_slot_);
+  if (map_page == nullptr) {
+    return;
+  }
+  map_page->Append(heap_page_id, category);
+  buffer_pool_manager_->UnpinPage(map_page->GetPageId(), true);
+  slots_[heap_page_id] = next_slot_++;
+}
+
+void FreeSpaceMap::Remove(page_id_t heap_page_id) {
+  std::scoped_lock lock(latch_);
+  auto it = slots_.find(heap_page_id);
+  if (it == slots_.end()) {
+    return;
+  }
+  // The slot is not reused; with category 0 it is never offered.
+  if (auto map_page = FetchMapPage(it->second); map_page != nullptr) {
+    map_page->SetCategory(it->second % FreeSpaceMapPage::CAPACITY, 0);
+    buffer_pool_manager_->UnpinPage(map_page->GetPageId(), true);
+  }
+  slots_.erase(it);
+  for (auto &target : targets_) {
+    if (target == heap_page_id) {
+      target = INVALID_PAGE_ID;
+    }
+  }
+}
+
+auto FreeSpaceMap::FindPage(uint32_t bytes) -> page_id_t {
+  const uint32_t needed = FreeSpaceMapPage::CategoryFor(bytes);
+  std::scoped_lock lock(latch_);
+  auto &target = targets_[std::hash<std::thread::id>{}(std::this_thread::get_id()) % TARGET_SLOTS];
+  if (target != INVALID_PAGE_ID && CategoryOf(target) >= needed) {
+    return target;
+  }
+
+  // The target is full: take the first page with room that no other thread inserts into, or else the first page with
+  // room at all.
+  page_id_t found = INVALID_PAGE_ID;
+  for (page_id_t map_page_id : map_pages_) {
+    auto map_page = reinterpret_cast<FreeSpaceMapPage *>(buffer_pool_manager_->FetchPage(map_page_id));
+    if (map_page == nullptr) {
+      break;
+    }
+    bool done = false;
+    for (uint32_t slot = 0; slot < map_page->GetCount(); slot++) {
+      if (map_page->GetCategory(slot) < needed) {
+        continue;
+      }
+      page_id_t heap_page_id = map_page->GetHeapPageId(slot);
+      if (found == INVALID_PAGE_ID) {
+        found = heap_page_id;
+      }
+      if (!IsOtherTarget(heap_page_id, target)) {
+        found = heap_page_id;
+        done = true;
+        break;
+      }
+    }
+    buffer_pool_manager_->UnpinPage(map_page_id, false);
+    if (done) {
+      break;
+    }
+  }
+  target = found;
+  return found;
+}
+
+auto FreeSpaceMap::PageCount() -> size_t {
+  std::scoped_lock lock(latch_);
+  return slots_.size();
+}
+
+auto FreeSpaceMap::FetchMapPage(size_t slot) -> FreeSpaceMapPage * {
+  return reinterpret_cast<FreeSpaceMapPage *>(
+      buffer_pool_manager_->FetchPage(map_pages_[slot / FreeSpaceMapPage::CAPACITY]));
+}
+
+auto FreeSpaceMap::CategoryOf(page_id_t heap_page_id) -> uint32_t {
+  auto it = slots_.find(heap_page_id);
+  if (it == slots_.end()) {
+    return 0;
+  }
+  auto map_page = FetchMapPage(it->second);
+  if (map_page == nullptr) {
+    return 0;
+  }
+  uint32_t category = map_page->GetCategory(it->second % FreeSpaceMapPage::CAPACITY);
+  buffer_pool_manager_->UnpinPage(map_page->GetPageId(), false);
+  return category;
+}
+
+auto FreeSpaceMap::IsOtherTarget(page_id_t heap_page_id, const page_id_t &self) const -> bool {
+  for (const auto &target : targets_) {
+    if (&target != &self && target == heap_page_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bustub
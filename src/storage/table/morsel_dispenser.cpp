@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_dispenser.cpp
+//
+// Identification: src/storage/table/morsel_dispenser.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/morsel_dispenser.h"
+
+namespace bustub {
+
+auto MorselDispenser::Next(std::vector<page_id_t> *pages) -> bool {
+  pages->clear();
+  std::scoped_lock lock(latch_);
+  while (next_page_id_ != INVALID_PAGE_ID && pages->size() < pages_per_morsel_) {
+    pages->push_back(next_page_id_);
+    next_page_id_ = table_heap_->GetNextPageId(next_page_id_);
+  }
+  return !pages->empty();
+}
+
+void MorselDispenser::Reset() {
+  std::scoped_lock lock(latch_);
+  next_page_id_ = table_heap_->GetFirstPageId();
+}
+
+}  // namespace bustub
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <cassert>
+#include <vector>
 
 #include "common/logger.h"
 #include "fmt/format.h"
@@ -23,17 +24,37 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
     : buffer_pool_manager_(buffer_pool_manager),
       lock_manager_(lock_manager),
       log_manager_(log_manager),
-      first_page_id_(first_page_id) {}
+      first_page_id_(first_page_id),
+      last_page_id_(first_page_id),
+      free_space_map_(buffer_pool_manager) {
+  // The free space map is not persisted with the table; rebuild it from the page chain.
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+    page->RLatch();
+    free_space_map_.Update(page_id, page->GetFreeSpaceRemaining());
+    last_page_id_ = page_id;
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
 
 TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
                      Transaction *txn)
-    : buffer_pool_manager_(buffer_pool_manager), lock_manager_(lock_manager), log_manager_(log_manager) {
+    : buffer_pool_manager_(buffer_pool_manager),
+      lock_manager_(lock_manager),
+      log_manager_(log_manager),
+      free_space_map_(buffer_pool_manager) {
   // Initialize the first table page.
   auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(&first_page_id_));
   BUSTUB_ASSERT(first_page != nullptr,
                 "Couldn't create a page for the table heap. Have you completed the buffer pool manager project?");
   first_page->Init(first_page_id_, BUSTUB_PAGE_SIZE, INVALID_LSN, log_manager_, txn);
+  free_space_map_.Update(first_page_id_, first_page->GetFreeSpaceRemaining());
   buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  last_page_id_ = first_page_id_;
 }
 
 auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool {
@@ -41,56 +62,143 @@ auto TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> b
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
+  if (!PlaceTuple(tuple, rid, txn)) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  // Update the transaction's write set.
+  txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
+  return true;
+}
+
+auto TableHeap::PlaceTuple(const Tuple &tuple, RID *rid, Transaction *txn) -> bool {
+  // Insert into a page that the free space map says has room. The page may have filled up since its entry was last
+  // updated, in which case we correct the entry and ask again.
+  const uint32_t needed = TablePage::SpaceNeeded(tuple.size_);
+  for (auto page_id = free_space_map_.FindPage(needed); page_id != INVALID_PAGE_ID;
+       page_id = free_space_map_.FindPage(needed)) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      return false;
+    }
+    page->WLatch();
+    bool inserted = page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_);
+    free_space_map_.Update(page_id, page->GetFreeSpaceRemaining());
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, inserted);
+    if (inserted) {
+      return true;
+    }
+  }
 
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+  // No page has room, so the tuple goes to the end of the table, into a new page unless the last page filled up only
+  // since the map was asked.
+  auto cur_page = LatchLastPage();
   if (cur_page == nullptr) {
-    txn->SetState(TransactionState::ABORTED);
     return false;
   }
+  if (!cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
+    cur_page = AppendPage(cur_page, txn);
+    if (cur_page == nullptr) {
+      return false;
+    }
+    bool inserted = cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_);
+    BUSTUB_ENSURE(inserted, "a fresh page must take the tuple");
+  }
+  free_space_map_.Update(cur_page->GetTablePageId(), cur_page->GetFreeSpaceRemaining());
+  cur_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
+  return true;
+}
 
-  cur_page->WLatch();
+auto TableHeap::InsertTuples(const std::vector<Tuple> &tuples, std::vector<RID> *rids, Transaction *txn) -> bool {
+  for (const auto &tuple : tuples) {
+    if (tuple.size_ + 32 > BUSTUB_PAGE_SIZE) {  // larger than one page size
+      txn->SetState(TransactionState::ABORTED);
+      return false;
+    }
+  }
+  rids->resize(tuples.size());
+  if (tuples.empty()) {
+    return true;
+  }
 
-  // Insert into the first page with enough space. If no such page exists, create a new page and insert into that.
-  // INVARIANT: cur_page is WLatched if you leave the loop normally.
-  while (!cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
-    auto next_page_id = cur_page->GetNextPageId();
-    // If the next page is a valid page,
-    if (next_page_id != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
-      next_page->WLatch();
-      // Unlatch and unpin the current page.
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
-      cur_page = next_page;
-    } else {
-      // Otherwise we have run out of valid pages. We need to create a new page.
-      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&next_page_id));
-      // If we could not create a new page,
-      if (new_page == nullptr) {
-        // Then life sucks and we abort the transaction.
-        cur_page->WUnlatch();
-        buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
-        txn->SetState(TransactionState::ABORTED);
-        return false;
+  auto cur_page = LatchLastPage();
+  if (cur_page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return false;
+  }
+  // INVARIANT: cur_page is the WLatched last page of the chain.
+  auto write_set = txn->GetWriteSet();
+  for (size_t i = 0; i < tuples.size(); i++) {
+    if (cur_page->InsertTuple(tuples[i], &(*rids)[i], txn, lock_manager_, log_manager_)) {
+      continue;
+    }
+    cur_page = AppendPage(cur_page, txn);
+    if (cur_page == nullptr) {
+      // The tuples placed so far stay in the write set, so that aborting the transaction removes them.
+      rids->resize(i);
+      for (const auto &rid : *rids) {
+        write_set->emplace_back(rid, WType::INSERT, Tuple{}, this);
       }
-      // Otherwise we were able to create a new page. We initialize it now.
-      new_page->WLatch();
-      cur_page->SetNextPageId(next_page_id);
-      new_page->Init(next_page_id, BUSTUB_PAGE_SIZE, cur_page->GetTablePageId(), log_manager_, txn);
-      cur_page->WUnlatch();
-      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
-      cur_page = new_page;
+      txn->SetState(TransactionState::ABORTED);
+      return false;
     }
+    // A fresh page holds any tuple that passed the size check above.
+    bool inserted = cur_page->InsertTuple(tuples[i], &(*rids)[i], txn, lock_manager_, log_manager_);
+    BUSTUB_ENSURE(inserted, "a fresh page must take the tuple");
   }
-  // This line has caused most of us to double-take and "whoa double unlatch".
-  // We are not, in fact, double unlatching. See the invariant above.
+  free_space_map_.Update(cur_page->GetTablePageId(), cur_page->GetFreeSpaceRemaining());
   cur_page->WUnlatch();
   buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
-  // Update the transaction's write set.
-  txn->GetWriteSet()->emplace_back(*rid, WType::INSERT, Tuple{}, this);
+
+  for (const auto &rid : *rids) {
+    write_set->emplace_back(rid, WType::INSERT, Tuple{}, this);
+  }
   return true;
 }
 
+auto TableHeap::LatchLastPage() -> TablePage * {
+  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+  if (cur_page == nullptr) {
+    return nullptr;
+  }
+  cur_page->WLatch();
+  // Other inserts may have appended pages since the hint was set; follow the chain to its end.
+  for (auto next_page_id = cur_page->GetNextPageId(); next_page_id != INVALID_PAGE_ID;
+       next_page_id = cur_page->GetNextPageId()) {
+    auto next_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+    if (next_page == nullptr) {
+      cur_page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
+      return nullptr;
+    }
+    next_page->WLatch();
+    cur_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
+    cur_page = next_page;
+  }
+  return cur_page;
+}
+
+auto TableHeap::AppendPage(TablePage *last_page, Transaction *txn) -> TablePage * {
+  page_id_t new_page_id;
+  auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&new_page_id));
+  if (new_page == nullptr) {
+    last_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(last_page->GetTablePageId(), true);
+    return nullptr;
+  }
+  new_page->WLatch();
+  last_page->SetNextPageId(new_page_id);
+  new_page->Init(new_page_id, BUSTUB_PAGE_SIZE, last_page->GetTablePageId(), log_manager_, txn);
+  free_space_map_.Update(last_page->GetTablePageId(), last_page->GetFreeSpaceRemaining());
+  last_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(last_page->GetTablePageId(), true);
+  last_page_id_ = new_page_id;
+  return new_page;
+}
+
 auto TableHeap::MarkDelete(const RID &rid, Transaction *txn) -> bool {
   // TODO(Amadou): remove empty page
   // Find the page which contains the tuple.
@@ -122,6 +230,9 @@ auto TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
   Tuple old_tuple;
   page->WLatch();
   bool is_updated = page->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
+  if (is_updated) {
+    free_space_map_.Update(rid.GetPageId(), page->GetFreeSpaceRemaining());
+  }
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
   // Update the transaction's write set.
@@ -138,6 +249,7 @@ void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
   // Delete the tuple from the page.
   page->WLatch();
   page->ApplyDelete(rid, txn, log_manager_);
+  free_space_map_.Update(rid.GetPageId(), page->GetFreeSpaceRemaining());
   /** Commented out to make compatible with p4; This is called only on commit or delete, which consequently unlocks the
    * tuple; so should be fine */
   // lock_manager_->Unlock(txn, rid);
@@ -176,6 +288,165 @@ auto TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, bool ac
   return res;
 }
 
+auto TableHeap::PinPage(page_id_t page_id) -> TablePageGuard {
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  BUSTUB_ENSURE(page != nullptr, "BPM full");
+  return {buffer_pool_manager_, page};
+}
+
+void TableHeap::GetTuples(const std::vector<RID> &rids, Transaction *txn, std::vector<Tuple> *tuples,
+                          std::vector<bool> *found) {
+  tuples->resize(rids.size());
+  found->assign(rids.size(), false);
+  size_t begin = 0;
+  while (begin < rids.size()) {
+    const page_id_t page_id = rids[begin].GetPageId();
+    size_t end = begin + 1;
+    while (end < rids.size() && rids[end].GetPageId() == page_id) {
+      end++;
+    }
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      txn->SetState(TransactionState::ABORTED);
+      return;
+    }
+    page->RLatch();
+    for (size_t i = begin; i < end; i++) {
+      (*found)[i] = page->GetTuple(rids[i], &(*tuples)[i], txn, lock_manager_);
+    }
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    begin = end;
+  }
+}
+
+auto TableHeap::Vacuum(Transaction *txn, const std::unordered_set<page_id_t> &busy_pages,
+                       const TupleMoveCallback &on_move) -> VacuumStats {
+  VacuumStats stats;
+  // Compact every page, and find the pages that are mostly empty. The first and the last page stay in any case.
+  std::vector<page_id_t> sparse_pages;
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+    page->WLatch();
+    bool compacted = page->GetDeadSpace() > 0;
+    if (compacted) {
+      stats.reclaimed_bytes_ += page->Compact();
+      stats.compacted_pages_++;
+    }
+    free_space_map_.Update(page_id, page->GetFreeSpaceRemaining());
+    page_id_t next_page_id = page->GetNextPageId();
+    if (page_id != first_page_id_ && next_page_id != INVALID_PAGE_ID && !page->HasPendingDeletes() &&
+        busy_pages.count(page_id) == 0 && page->GetFreeSpaceRemaining() > BUSTUB_PAGE_SIZE * 3 / 4) {
+      sparse_pages.push_back(page_id);
+    }
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, compacted);
+    page_id = next_page_id;
+  }
+
+  // Keep the tuples of sparse pages from going into other sparse pages, then empty and release them one by one.
+  for (auto page_id : sparse_pages) {
+    free_space_map_.Remove(page_id);
+  }
+  for (auto page_id : sparse_pages) {
+    if (EmptyPage(page_id, txn, on_move, &stats) && ReleasePage(page_id)) {
+      stats.released_pages_++;
+    }
+  }
+  return stats;
+}
+
+auto TableHeap::EmptyPage(page_id_t page_id, Transaction *txn, const TupleMoveCallback &on_move, VacuumStats *stats)
+    -> bool {
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+  // The page is neither in the free space map nor the last page, so the inserts below latch other pages only, and
+  // nobody waits for this page while holding the latch of another one.
+  page->WLatch();
+  std::vector<Tuple> tuples;
+  std::vector<RID> new_rids;
+  RID rid;
+  // A delete marked since the page was chosen must stay where its transaction can find it.
+  if (!page->HasPendingDeletes()) {
+    for (bool found = page->GetFirstTupleRid(&rid); found; found = page->GetNextTupleRid(rid, &rid)) {
+      // Insert the copy first, so that a failed insert leaves the tuple where it is.
+      Tuple tuple;
+      page->GetTuple(rid, &tuple, txn, lock_manager_);
+      RID new_rid;
+      if (!PlaceTuple(tuple, &new_rid, txn)) {
+        break;
+      }
+      page->ApplyDelete(rid, txn, log_manager_);
+      tuples.push_back(std::move(tuple));
+      new_rids.push_back(new_rid);
+    }
+  }
+  bool empty = !page->GetFirstTupleRid(&rid);
+  if (!empty) {
+    free_space_map_.Update(page_id, page->GetFreeSpaceRemaining());
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, !new_rids.empty());
+
+  for (size_t i = 0; i < new_rids.size(); i++) {
+    on_move(tuples[i], tuples[i].GetRid(), new_rids[i]);
+  }
+  stats->moved_tuples_ += new_rids.size();
+  return empty;
+}
+
+auto TableHeap::ReleasePage(page_id_t page_id) -> bool {
+  // Latch the page and its neighbours in chain order, the order in which inserts and scans latch pages too.
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  BUSTUB_ASSERT(page != nullptr, "Couldn't fetch a page of the table heap.");
+  page_id_t prev_page_id = page->GetPrevPageId();
+  auto prev_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(prev_page_id));
+  BUSTUB_ASSERT(prev_page != nullptr, "Couldn't fetch a page of the table heap.");
+  prev_page->WLatch();
+  page->WLatch();
+  // A scan that has the page pinned reads it after the latch, and a page deleted under it would be reused.
+  RID rid;
+  if (page->GetPinCount() > 1 || page->GetFirstTupleRid(&rid)) {
+    free_space_map_.Update(page_id, page->GetFreeSpaceRemaining());
+    page->WUnlatch();
+    prev_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->UnpinPage(prev_page_id, false);
+    return false;
+  }
+  page_id_t next_page_id = page->GetNextPageId();
+  BUSTUB_ASSERT(next_page_id != INVALID_PAGE_ID, "The last page stays in the chain.");
+  auto next_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+  BUSTUB_ASSERT(next_page != nullptr, "Couldn't fetch a page of the table heap.");
+  next_page->WLatch();
+  prev_page->SetNextPageId(next_page_id);
+  next_page->SetPrevPageId(prev_page_id);
+  if (last_page_id_ == page_id) {
+    last_page_id_ = prev_page_id;
+  }
+  next_page->WUnlatch();
+  page->WUnlatch();
+  prev_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(next_page_id, true);
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  buffer_pool_manager_->UnpinPage(prev_page_id, true);
+  // The statements that read the table are kept out while it is vacuumed, so nobody pins the page again now that it
+  // is out of the chain.
+  buffer_pool_manager_->DeletePage(page_id);
+  return true;
+}
+
+auto TableHeap::GetNextPageId(page_id_t page_id) -> page_id_t {
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  BUSTUB_ENSURE(page != nullptr, "BPM full");
+  page->RLatch();
+  auto next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id;
+}
+
 auto TableHeap::Begin(Transaction *txn) -> TableIterator {
   // Start an iterator from the first page.
   // TODO(Wuwen): Hacky fix for now. Removing empty pages is a better way to handle this.
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_file.cpp
+//
+// Identification: src/storage/table/tmp_tuple_file.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_file.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+
+TmpTupleFile::~TmpTupleFile() {
+  FinishWrite();
+  ReleaseReadPage();
+  for (auto page_id : pages_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void TmpTupleFile::Append(const Tuple &tuple) {
+  TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+  if (write_page_ != nullptr && write_page_->Insert(tuple, &tmp_tuple)) {
+    num_tuples_++;
+    num_bytes_ += tuple.GetLength();
+    return;
+  }
+  FinishWrite();
+
+  page_id_t page_id;
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm_->NewPage(&page_id));
+  if (page == nullptr) {
+    throw ExecutionException("no free frame in the buffer pool to spill tuples to");
+  }
+  page->Init(page_id, BUSTUB_PAGE_SIZE);
+  pages_.push_back(page_id);
+  write_page_ = page;
+  if (!write_page_->Insert(tuple, &tmp_tuple)) {
+    throw ExecutionException("tuple is too large to be spilled");
+  }
+  num_tuples_++;
+  num_bytes_ += tuple.GetLength();
+}
+
+void TmpTupleFile::FinishWrite() {
+  if (write_page_ != nullptr) {
+    bpm_->UnpinPage(write_page_->GetTablePageId(), true);
+    write_page_ = nullptr;
+  }
+}
+
+void TmpTupleFile::Rewind() {
+  FinishWrite();
+  ReleaseReadPage();
+  read_page_idx_ = 0;
+}
+
+void TmpTupleFile::LoadReadPage() {
+  auto *page = bpm_->FetchPage(pages_[read_page_idx_]);
+  if (page == nullptr) {
+    throw ExecutionException("no free frame in the buffer pool to read spilled tuples");
+  }
+  read_page_ = reinterpret_cast<TmpTuplePage *>(page);
+  // Tuples grow from the end of the page towards the header, so walking from the free space pointer visits the most
+  // recently inserted tuple first.
+  read_offsets_.clear();
+  for (uint32_t offset = read_page_->GetFreeSpacePointer(); offset < BUSTUB_PAGE_SIZE;) {
+    read_offsets_.push_back(offset);
+    offset += sizeof(uint32_t) + *reinterpret_cast<const uint32_t *>(read_page_->GetData() + offset);
+  }
+}
+
+void TmpTupleFile::ReleaseReadPage() {
+  if (read_page_ != nullptr) {
+    bpm_->UnpinPage(pages_[read_page_idx_], false);
+    read_page_ = nullptr;
+  }
+}
+
+auto TmpTupleFile::Next(Tuple *tuple) -> bool {
+  while (read_page_ == nullptr || read_offsets_.empty()) {
+    if (read_page_ != nullptr) {
+      ReleaseReadPage();
+      read_page_idx_++;
+    }
+    if (read_page_idx_ >= pages_.size()) {
+      return false;
+    }
+    LoadReadPage();
+  }
+  read_page_->Get(TmpTuple(pages_[read_page_idx_], read_offsets_.back()), tuple);
+  read_offsets_.pop_back();
+  return true;
+}
+
+}  // namespace bustub
@@ -75,12 +75,32 @@ Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_
   }
 }
 
+Tuple::Tuple(Tuple &&other) noexcept
+    : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_), data_(other.data_) {
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+}
+
+Tuple::Tuple(const Tuple &other, Arena *arena) : rid_(other.rid_), size_(other.size_) {
+  data_ = static_cast<char *>(arena->Allocate(size_));
+  memcpy(data_, other.data_, size_);
+}
+
 auto Tuple::operator=(const Tuple &other) -> Tuple & {
+  if (this == &other) {
+    return *this;
+  }
+  rid_ = other.rid_;
+  if (allocated_ && other.allocated_ && size_ == other.size_) {
+    // Same length, e.g. rows of one schema without varchars: reuse the buffer.
+    memcpy(data_, other.data_, size_);
+    return *this;
+  }
   if (allocated_) {
     delete[] data_;
   }
   allocated_ = other.allocated_;
-  rid_ = other.rid_;
   size_ = other.size_;
 
   if (allocated_) {
@@ -95,6 +115,23 @@ auto Tuple::operator=(const Tuple &other) -> Tuple & {
   return *this;
 }
 
+auto Tuple::operator=(Tuple &&other) noexcept -> Tuple & {
+  if (this == &other) {
+    return *this;
+  }
+  if (allocated_) {
+    delete[] data_;
+  }
+  allocated_ = other.allocated_;
+  rid_ = other.rid_;
+  size_ = other.size_;
+  data_ = other.data_;
+  other.allocated_ = false;
+  other.size_ = 0;
+  other.data_ = nullptr;
+  return *this;
+}
+
 auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
   assert(schema);
   assert(data_);
@@ -104,7 +141,30 @@ auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> V
   return Value::DeserializeFrom(data_ptr, column_type);
 }
 
-auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs)
+auto Tuple::Concat(const Tuple &left, const Schema &left_schema, const Tuple &right, const Schema &right_schema)
+    -> Tuple {
+  const uint32_t left_fixed = left_schema.GetLength();
+  const uint32_t right_fixed = right_schema.GetLength();
+  Tuple tuple;
+  tuple.allocated_ = true;
+  tuple.size_ = left.size_ + right.size_;
+  tuple.data_ = new char[tuple.size_];
+  // Both fixed-size parts come first, followed by both varied-sized payloads.
+  memcpy(tuple.data_, left.data_, left_fixed);
+  memcpy(tuple.data_ + left_fixed, right.data_, right_fixed);
+  memcpy(tuple.data_ + left_fixed + right_fixed, left.data_ + left_fixed, left.size_ - left_fixed);
+  memcpy(tuple.data_ + left.size_ + right_fixed, right.data_ + right_fixed, right.size_ - right_fixed);
+  // Move the payload offsets along with the payloads.
+  for (auto i : left_schema.GetUnlinedColumns()) {
+    *reinterpret_cast<uint32_t *>(tuple.data_ + left_schema.GetColumn(i).GetOffset()) += right_fixed;
+  }
+  for (auto i : right_schema.GetUnlinedColumns()) {
+    *reinterpret_cast<uint32_t *>(tuple.data_ + left_fixed + right_schema.GetColumn(i).GetOffset()) += left.size_;
+  }
+  return tuple;
+}
+
+auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
     -> Tuple {
   std::vector<Value> values;
   values.reserve(key_attrs.size());
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_test.cpp
+//
+// Identification: test/common/arena_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <set>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/arena.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, AllocateTest) {
+  Arena arena(1024);
+  EXPECT_EQ(0, arena.GetChunks());
+
+  std::vector<char *> blocks;
+  for (int i = 0; i < 100; i++) {
+    auto *block = static_cast<char *>(arena.Allocate(i + 1));
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(block) % Arena::ALIGNMENT);
+    memset(block, i, i + 1);
+    blocks.push_back(block);
+  }
+  // nothing overlaps
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j <= i; j++) {
+      ASSERT_EQ(static_cast<char>(i), blocks[i][j]);
+    }
+  }
+  EXPECT_EQ(100, arena.GetAllocations());
+  EXPECT_EQ(5050, arena.GetAllocatedBytes());
+  size_t chunks = arena.GetChunks();
+  EXPECT_GT(chunks, 1);
+  EXPECT_EQ(chunks * 1024, arena.GetReservedBytes());
+
+  // a large allocation gets a chunk of its own and leaves the current one alone
+  auto *large = static_cast<char *>(arena.Allocate(4096));
+  memset(large, 1, 4096);
+  EXPECT_EQ(chunks + 1, arena.GetChunks());
+  EXPECT_EQ(chunks * 1024 + 4096, arena.GetReservedBytes());
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, MemoryResourceTest) {
+  Arena arena;
+  std::pmr::vector<int64_t> values(&arena);
+  for (int64_t i = 0; i < 1000; i++) {
+    values.push_back(i);
+  }
+  for (int64_t i = 0; i < 1000; i++) {
+    ASSERT_EQ(i, values[i]);
+  }
+  EXPECT_GT(arena.GetAllocations(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, ConcurrentAllocateTest) {
+  Arena arena(4096);
+  const int num_threads = 4;
+  const int per_thread = 1000;
+  std::vector<std::vector<int64_t *>> blocks(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < per_thread; i++) {
+        auto *block = static_cast<int64_t *>(arena.Allocate(sizeof(int64_t) * 3));
+        block[0] = block[1] = block[2] = t * per_thread + i;
+        blocks[t].push_back(block);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::set<int64_t *> distinct;
+  for (int t = 0; t < num_threads; t++) {
+    for (int i = 0; i < per_thread; i++) {
+      int64_t *block = blocks[t][i];
+      ASSERT_EQ(t * per_thread + i, block[0]);
+      ASSERT_EQ(block[0], block[2]);
+      distinct.insert(block);
+    }
+  }
+  EXPECT_EQ(num_threads * per_thread, distinct.size());
+  EXPECT_EQ(num_threads * per_thread, arena.GetAllocations());
+}
+
+}  // namespace bustub
@@ -0,0 +1,150 @@
+/**
+ * adaptive_radix_tree_test.cpp
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "container/art/adaptive_radix_tree.h"
+#include "gtest/gtest.h"
+#include "storage/index/normalized_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** Encode an integer key like the index does. */
+static auto IntKey(int32_t v) -> std::vector<uint8_t> {
+  std::vector<uint8_t> key;
+  NormalizedKey::AppendValue(ValueFactory::GetIntegerValue(v), &key);
+  return key;
+}
+
+static auto StringKey(const std::string &v) -> std::vector<uint8_t> {
+  std::vector<uint8_t> key;
+  NormalizedKey::AppendValue(ValueFactory::GetVarcharValue(v), &key);
+  return key;
+}
+
+TEST(AdaptiveRadixTreeTest, NormalizedKeyOrderTest) {
+  std::vector<int32_t> ints{-100000, -256, -1, 0, 1, 255, 256, 70000};
+  for (size_t i = 1; i < ints.size(); i++) {
+    EXPECT_LT(IntKey(ints[i - 1]), IntKey(ints[i]));
+  }
+  std::vector<std::string> strings{"", std::string("a\0", 2), "a", "ab", "b"};
+  std::sort(strings.begin(), strings.end());
+  for (size_t i = 1; i < strings.size(); i++) {
+    EXPECT_LT(StringKey(strings[i - 1]), StringKey(strings[i]));
+  }
+  std::vector<uint8_t> null_key;
+  NormalizedKey::AppendValue(ValueFactory::GetNullValueByType(TypeId::INTEGER), &null_key);
+  EXPECT_LT(null_key, IntKey(-100000));
+}
+
+TEST(AdaptiveRadixTreeTest, SampleTest) {
+  AdaptiveRadixTree<int64_t> tree;
+  auto k1 = IntKey(1);
+  auto k2 = IntKey(2);
+  std::vector<int64_t> result;
+
+  EXPECT_TRUE(tree.Insert(k1.data(), k1.size(), 10));
+  EXPECT_TRUE(tree.Insert(k2.data(), k2.size(), 20));
+  // duplicate keys keep all their values, duplicate pairs are rejected
+  EXPECT_TRUE(tree.Insert(k1.data(), k1.size(), 11));
+  EXPECT_FALSE(tree.Insert(k1.data(), k1.size(), 11));
+
+  EXPECT_TRUE(tree.GetValue(k1.data(), k1.size(), &result));
+  EXPECT_EQ((std::vector<int64_t>{10, 11}), result);
+  result.clear();
+  auto k3 = IntKey(3);
+  EXPECT_FALSE(tree.GetValue(k3.data(), k3.size(), &result));
+
+  EXPECT_TRUE(tree.Remove(k1.data(), k1.size(), 10));
+  EXPECT_FALSE(tree.Remove(k1.data(), k1.size(), 10));
+  EXPECT_FALSE(tree.Remove(k3.data(), k3.size(), 10));
+  EXPECT_TRUE(tree.GetValue(k1.data(), k1.size(), &result));
+  EXPECT_EQ((std::vector<int64_t>{11}), result);
+  EXPECT_TRUE(tree.Remove(k1.data(), k1.size(), 11));
+  EXPECT_FALSE(tree.GetValue(k1.data(), k1.size(), &result));
+}
+
+TEST(AdaptiveRadixTreeTest, GrowAndRemoveTest) {
+  AdaptiveRadixTree<int64_t> tree;
+  // Dense keys fill every node type up to Node256 below the root.
+  const int num_keys = 20000;
+  for (int i = 0; i < num_keys; i++) {
+    auto key = IntKey(i - num_keys / 2);
+    EXPECT_TRUE(tree.Insert(key.data(), key.size(), i));
+  }
+  for (int i = 0; i < num_keys; i += 2) {
+    auto key = IntKey(i - num_keys / 2);
+    EXPECT_TRUE(tree.Remove(key.data(), key.size(), i));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    auto key = IntKey(i - num_keys / 2);
+    std::vector<int64_t> result;
+    EXPECT_EQ(i % 2 == 1, tree.GetValue(key.data(), key.size(), &result));
+    if (i % 2 == 1) {
+      EXPECT_EQ(std::vector<int64_t>{i}, result);
+    }
+  }
+}
+
+TEST(AdaptiveRadixTreeTest, LongPrefixTest) {
+  AdaptiveRadixTree<int64_t> tree;
+  // The shared part is longer than one compressed prefix, and later keys split it in the middle.
+  std::vector<std::string> strings{std::string(40, 'x') + "1", std::string(40, 'x') + "2", std::string(20, 'x'),
+                                   std::string(30, 'x') + "y", "x", "xy", std::string(40, 'x') + std::string(1, '\0')};
+  for (size_t i = 0; i < strings.size(); i++) {
+    auto key = StringKey(strings[i]);
+    EXPECT_TRUE(tree.Insert(key.data(), key.size(), i));
+  }
+  for (size_t i = 0; i < strings.size(); i++) {
+    auto key = StringKey(strings[i]);
+    std::vector<int64_t> result;
+    EXPECT_TRUE(tree.GetValue(key.data(), key.size(), &result));
+    EXPECT_EQ(std::vector<int64_t>{static_cast<int64_t>(i)}, result);
+  }
+  auto missing = StringKey(std::string(40, 'x'));
+  std::vector<int64_t> result;
+  EXPECT_FALSE(tree.GetValue(missing.data(), missing.size(), &result));
+}
+
+TEST(AdaptiveRadixTreeTest, ConcurrentInsertTest) {
+  const int num_runs = 20;
+  const int num_threads = 4;
+  const int keys_per_thread = 1000;
+
+  // Run concurrent test multiple times to guarantee correctness.
+  for (int run = 0; run < num_runs; run++) {
+    auto tree = std::make_unique<AdaptiveRadixTree<int64_t>>();
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+
+    // Interleave the keys of the threads, so that they keep growing and splitting the same nodes.
+    for (int tid = 0; tid < num_threads; tid++) {
+      threads.emplace_back([tid, &tree]() {
+        for (int i = 0; i < keys_per_thread; i++) {
+          auto key = IntKey(i * num_threads + tid);
+          tree->Insert(key.data(), key.size(), tid);
+          std::vector<int64_t> result;
+          EXPECT_TRUE(tree->GetValue(key.data(), key.size(), &result));
+        }
+      });
+    }
+    for (int i = 0; i < num_threads; i++) {
+      threads[i].join();
+    }
+
+    for (int i = 0; i < num_threads * keys_per_thread; i++) {
+      auto key = IntKey(i);
+      std::vector<int64_t> result;
+      EXPECT_TRUE(tree->GetValue(key.data(), key.size(), &result));
+      EXPECT_EQ(std::vector<int64_t>{i % num_threads}, result);
+    }
+  }
+}
+
+}  // namespace bustub
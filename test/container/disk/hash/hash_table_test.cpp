@@ -24,7 +24,7 @@ namespace bustub {
 // NOLINTNEXTLINE
 
 // NOLINTNEXTLINE
-TEST(HashTableTest, DISABLED_SampleTest) {
+TEST(HashTableTest, SampleTest) {
   auto *disk_manager = new DiskManager("test.db");
   auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
   DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
@@ -117,4 +117,128 @@ TEST(HashTableTest, DISABLED_SampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTableTest, GrowShrinkTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // enough keys to split buckets several times
+  const int num_keys = 5000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i)) << "Failed to insert " << i << std::endl;
+  }
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+  ht.VerifyIntegrity();
+
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // emptying the table merges every bucket back together
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i)) << "Failed to remove " << i << std::endl;
+  }
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+  ht.VerifyIntegrity();
+
+  for (int i = 0; i < num_keys; i += 97) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(0, res.size());
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, OutOfPagesTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(3, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  // the directory and the bucket take two frames, so pinning the third leaves no frame for a split image
+  page_id_t pinned_page_id;
+  ASSERT_NE(nullptr, bpm->NewPage(&pinned_page_id));
+  const int bucket_size = 4 * BUSTUB_PAGE_SIZE / (4 * sizeof(std::pair<int, int>) + 1);
+  for (int i = 0; i < bucket_size; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i)) << "Failed to insert " << i << std::endl;
+  }
+  EXPECT_FALSE(ht.Insert(nullptr, bucket_size, bucket_size));
+  EXPECT_EQ(0, ht.GetGlobalDepth());
+  ht.VerifyIntegrity();
+
+  // with the frame back the split goes through
+  bpm->UnpinPage(pinned_page_id, false);
+  EXPECT_TRUE(ht.Insert(nullptr, bucket_size, bucket_size));
+  EXPECT_EQ(1, ht.GetGlobalDepth());
+  ht.VerifyIntegrity();
+  for (int i = 0; i <= bucket_size; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+  }
+
+  // with every frame pinned elsewhere not even the directory can be fetched, and every operation fails
+  std::vector<page_id_t> page_ids(3);
+  for (auto &page_id : page_ids) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  }
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 0, &res));
+  EXPECT_FALSE(ht.Insert(nullptr, -1, -1));
+  EXPECT_FALSE(ht.Remove(nullptr, 0, 0));
+  for (auto page_id : page_ids) {
+    bpm->UnpinPage(page_id, false);
+  }
+  EXPECT_TRUE(ht.GetValue(nullptr, 0, &res));
+  EXPECT_TRUE(ht.Remove(nullptr, 0, 0));
+  ht.VerifyIntegrity();
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableTest, ConcurrentInsertTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  DiskExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+
+  const int num_threads = 4;
+  const int keys_per_thread = 1000;
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([tid, &ht]() {
+      for (int i = tid * keys_per_thread; i < (tid + 1) * keys_per_thread; i++) {
+        ht.Insert(nullptr, i, i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ht.VerifyIntegrity();
+
+  for (int i = 0; i < num_threads * keys_per_thread; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Failed to keep " << i << std::endl;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
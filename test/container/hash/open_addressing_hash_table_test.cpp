@@ -0,0 +1,111 @@
+/**
+ * open_addressing_hash_table_test.cpp
+ */
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/config.h"
+#include "container/hash/open_addressing_hash_table.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(OpenAddressingHashTableTest, SampleTest) {
+  auto table = std::make_unique<OpenAddressingHashTable<int, std::string>>(4, 2);
+
+  table->Insert(1, "a");
+  table->Insert(2, "b");
+  table->Insert(3, "c");
+  table->Insert(4, "d");
+  table->Insert(5, "e");
+  table->Insert(6, "f");
+  table->Insert(7, "g");
+  table->Insert(8, "h");
+  table->Insert(9, "i");
+  EXPECT_EQ(9, table->Size());
+
+  std::string result;
+  table->Find(9, result);
+  EXPECT_EQ("i", result);
+  table->Find(8, result);
+  EXPECT_EQ("h", result);
+  table->Find(2, result);
+  EXPECT_EQ("b", result);
+  EXPECT_FALSE(table->Find(10, result));
+
+  // existing keys are updated in place
+  table->Insert(2, "bb");
+  table->Find(2, result);
+  EXPECT_EQ("bb", result);
+  EXPECT_EQ(9, table->Size());
+
+  EXPECT_TRUE(table->Remove(8));
+  EXPECT_TRUE(table->Remove(4));
+  EXPECT_TRUE(table->Remove(1));
+  EXPECT_FALSE(table->Remove(20));
+  EXPECT_FALSE(table->Find(8, result));
+  EXPECT_EQ(6, table->Size());
+}
+
+TEST(OpenAddressingHashTableTest, GrowRemoveTest) {
+  auto table = std::make_unique<OpenAddressingHashTable<page_id_t, frame_id_t>>(8, 2);
+  size_t initial_capacity = table->GetCapacity();
+
+  const int num_keys = 10000;
+  for (int i = 0; i < num_keys; i++) {
+    table->Insert(i, i * 2);
+  }
+  EXPECT_EQ(num_keys, table->Size());
+  EXPECT_GT(table->GetCapacity(), initial_capacity);
+
+  // remove every other key; backward shifting must keep the rest reachable
+  for (int i = 0; i < num_keys; i += 2) {
+    EXPECT_TRUE(table->Remove(i));
+  }
+  for (int i = 0; i < num_keys; i++) {
+    frame_id_t value;
+    if (i % 2 == 0) {
+      EXPECT_FALSE(table->Find(i, value));
+    } else {
+      EXPECT_TRUE(table->Find(i, value));
+      EXPECT_EQ(i * 2, value);
+    }
+  }
+  EXPECT_EQ(num_keys / 2, table->Size());
+}
+
+TEST(OpenAddressingHashTableTest, ConcurrentInsertTest) {
+  const int num_runs = 50;
+  const int num_threads = 4;
+  const int keys_per_thread = 500;
+
+  // Run concurrent test multiple times to guarantee correctness.
+  for (int run = 0; run < num_runs; run++) {
+    auto table = std::make_unique<OpenAddressingHashTable<page_id_t, frame_id_t>>(8, 4);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+
+    for (int tid = 0; tid < num_threads; tid++) {
+      threads.emplace_back([tid, &table]() {
+        for (int i = tid * keys_per_thread; i < (tid + 1) * keys_per_thread; i++) {
+          table->Insert(i, tid);
+        }
+      });
+    }
+    for (int i = 0; i < num_threads; i++) {
+      threads[i].join();
+    }
+
+    EXPECT_EQ(num_threads * keys_per_thread, table->Size());
+    for (int i = 0; i < num_threads * keys_per_thread; i++) {
+      frame_id_t value;
+      EXPECT_TRUE(table->Find(i, value));
+      EXPECT_EQ(i / keys_per_thread, value);
+    }
+  }
+}
+
+}  // namespace bustub
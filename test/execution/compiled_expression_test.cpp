@@ -0,0 +1,121 @@
+/**
+ * compiled_expression_test.cpp
+ */
+
+#include <memory>
+#include <vector>
+
+#include "execution/compiled_expression.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+static void ExpectSameValue(const Value &expected, const Value &actual, const AbstractExpression &expr, size_t row) {
+  ASSERT_EQ(expected.IsNull(), actual.IsNull()) << expr.ToString() << " row " << row;
+  if (!expected.IsNull()) {
+    EXPECT_EQ(CmpBool::CmpTrue, expected.CompareEquals(actual)) << expr.ToString() << " row " << row;
+  }
+}
+
+/** The compiled program must give what Evaluate() gives on every tuple. */
+static void CheckAgainstTree(const AbstractExpression &expr, const std::vector<Tuple> &tuples, const Schema &schema) {
+  auto program = CompiledExpression::Compile(expr, schema);
+  ASSERT_NE(nullptr, program) << expr.ToString();
+  for (size_t i = 0; i < tuples.size(); i++) {
+    Value expected = expr.Evaluate(&tuples[i], schema);
+    ExpectSameValue(expected, program->Evaluate(&tuples[i]), expr, i);
+    if (expr.GetReturnType() == TypeId::BOOLEAN) {
+      EXPECT_EQ(!expected.IsNull() && expected.GetAs<bool>(), program->EvaluatePredicate(&tuples[i]));
+    }
+  }
+}
+
+TEST(CompiledExpressionTest, MatchesTreeTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::INTEGER},
+                                    Column{"c", TypeId::DECIMAL}, Column{"d", TypeId::VARCHAR, 16},
+                                    Column{"e", TypeId::BIGINT}, Column{"f", TypeId::BOOLEAN}}};
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 64; i++) {
+    // every seventh row has a NULL in column b, every fifth one in column f
+    Value b = i % 7 == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i % 5);
+    Value f =
+        i % 5 == 0 ? ValueFactory::GetNullValueByType(TypeId::BOOLEAN) : ValueFactory::GetBooleanValue(i % 2 == 0);
+    tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i), b, ValueFactory::GetDecimalValue(i / 2.0),
+                                           ValueFactory::GetVarcharValue("x"), ValueFactory::GetBigIntValue(i * 3L),
+                                           f},
+                        &schema);
+  }
+
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto b = std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER);
+  auto c = std::make_shared<ColumnValueExpression>(0, 2, TypeId::DECIMAL);
+  auto d = std::make_shared<ColumnValueExpression>(0, 3, TypeId::VARCHAR);
+  auto e = std::make_shared<ColumnValueExpression>(0, 4, TypeId::BIGINT);
+  auto f = std::make_shared<ColumnValueExpression>(0, 5, TypeId::BOOLEAN);
+  auto three = std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(3));
+  auto null = std::make_shared<ConstantValueExpression>(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+
+  auto sum = std::make_shared<ArithmeticExpression>(a, b, ArithmeticType::Plus);
+  auto diff = std::make_shared<ArithmeticExpression>(sum, three, ArithmeticType::Minus);
+  auto lt = std::make_shared<ComparisonExpression>(b, three, ComparisonType::LessThan);
+  auto gt_mirrored = std::make_shared<ComparisonExpression>(three, a, ComparisonType::GreaterThan);
+  auto ge = std::make_shared<ComparisonExpression>(c, a, ComparisonType::GreaterThanOrEqual);
+  auto ne = std::make_shared<ComparisonExpression>(diff, e, ComparisonType::NotEqual);
+  auto eq_null = std::make_shared<ComparisonExpression>(a, null, ComparisonType::Equal);
+  auto le_bigint = std::make_shared<ComparisonExpression>(e, a, ComparisonType::LessThanOrEqual);
+  CheckAgainstTree(*a, tuples, schema);
+  CheckAgainstTree(*c, tuples, schema);
+  CheckAgainstTree(*e, tuples, schema);
+  CheckAgainstTree(*f, tuples, schema);
+  CheckAgainstTree(*sum, tuples, schema);
+  CheckAgainstTree(*diff, tuples, schema);
+  CheckAgainstTree(*lt, tuples, schema);
+  CheckAgainstTree(*gt_mirrored, tuples, schema);
+  CheckAgainstTree(*ge, tuples, schema);
+  CheckAgainstTree(*ne, tuples, schema);
+  CheckAgainstTree(*eq_null, tuples, schema);
+  CheckAgainstTree(*le_bigint, tuples, schema);
+  CheckAgainstTree(LogicExpression(lt, f, LogicType::And), tuples, schema);
+  CheckAgainstTree(LogicExpression(lt, f, LogicType::Or), tuples, schema);
+  CheckAgainstTree(LogicExpression(eq_null, ge, LogicType::Or), tuples, schema);
+
+  // strings do not compile
+  EXPECT_EQ(nullptr, CompiledExpression::Compile(*d, schema));
+  EXPECT_EQ(nullptr, CompiledExpression::Compile(ComparisonExpression(d, d, ComparisonType::Equal), schema));
+
+  // `b < 3` is one fused instruction, `3 > a` too
+  EXPECT_EQ(1, CompiledExpression::Compile(*lt, schema)->Size());
+  EXPECT_EQ(1, CompiledExpression::Compile(*gt_mirrored, schema)->Size());
+}
+
+TEST(CompiledExpressionTest, JoinTest) {
+  Schema left_schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::DECIMAL}}};
+  Schema right_schema{std::vector<Column>{Column{"s", TypeId::VARCHAR, 8}, Column{"x", TypeId::INTEGER}}};
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto b = std::make_shared<ColumnValueExpression>(0, 1, TypeId::DECIMAL);
+  auto x = std::make_shared<ColumnValueExpression>(1, 1, TypeId::INTEGER);
+  auto eq = std::make_shared<ComparisonExpression>(a, x, ComparisonType::Equal);
+  auto lt = std::make_shared<ComparisonExpression>(b, x, ComparisonType::LessThan);
+  LogicExpression predicate(eq, lt, LogicType::Or);
+
+  auto program = CompiledExpression::CompileJoin(predicate, left_schema, right_schema);
+  ASSERT_NE(nullptr, program);
+  for (int i = 0; i < 8; i++) {
+    Value a_value = i == 3 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i);
+    Tuple left{{a_value, ValueFactory::GetDecimalValue(i * 0.75)}, &left_schema};
+    for (int j = 0; j < 8; j++) {
+      Tuple right{{ValueFactory::GetVarcharValue("r"), ValueFactory::GetIntegerValue(j)}, &right_schema};
+      Value expected = predicate.EvaluateJoin(&left, left_schema, &right, right_schema);
+      ExpectSameValue(expected, program->EvaluateJoin(&left, &right), predicate, i * 8 + j);
+      EXPECT_EQ(!expected.IsNull() && expected.GetAs<bool>(), program->EvaluatePredicate(&left, &right));
+    }
+  }
+}
+
+}  // namespace bustub
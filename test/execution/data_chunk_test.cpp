@@ -0,0 +1,82 @@
+/**
+ * data_chunk_test.cpp
+ */
+
+#include <memory>
+#include <vector>
+
+#include "execution/data_chunk.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** The vectorized result of `expr` over every selected row must match Evaluate() on the tuple. */
+static void CheckAgainstRows(const AbstractExpression &expr, const DataChunk &chunk, const TupleBatch &batch,
+                             const Schema &schema) {
+  ColumnVector result;
+  ASSERT_TRUE(expr.EvaluateVector(chunk, &result));
+  for (auto idx : chunk.GetSelection()) {
+    Value expected = expr.Evaluate(&batch.GetTuple(idx), schema);
+    Value actual = result.GetValue(idx);
+    ASSERT_EQ(expected.IsNull(), actual.IsNull()) << expr.ToString() << " row " << idx;
+    if (!expected.IsNull()) {
+      EXPECT_EQ(CmpBool::CmpTrue, expected.CompareEquals(actual)) << expr.ToString() << " row " << idx;
+    }
+  }
+}
+
+TEST(DataChunkTest, ExpressionKernelTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::INTEGER},
+                                    Column{"c", TypeId::DECIMAL}, Column{"d", TypeId::VARCHAR, 16}}};
+  TupleBatch batch(64);
+  for (int i = 0; i < 64; i++) {
+    // every seventh row has a NULL in column b
+    Value b = i % 7 == 0 ? ValueFactory::GetNullValueByType(TypeId::INTEGER) : ValueFactory::GetIntegerValue(i % 5);
+    batch.Append(Tuple{{ValueFactory::GetIntegerValue(i), b, ValueFactory::GetDecimalValue(i / 2.0),
+                        ValueFactory::GetVarcharValue("x")},
+                       &schema},
+                 RID(0, i));
+  }
+  DataChunk chunk;
+  chunk.Reset(&batch, &schema);
+
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto b = std::make_shared<ColumnValueExpression>(0, 1, TypeId::INTEGER);
+  auto c = std::make_shared<ColumnValueExpression>(0, 2, TypeId::DECIMAL);
+  auto d = std::make_shared<ColumnValueExpression>(0, 3, TypeId::VARCHAR);
+  auto three = std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(3));
+
+  auto sum = std::make_shared<ArithmeticExpression>(a, b, ArithmeticType::Plus);
+  auto lt = std::make_shared<ComparisonExpression>(b, three, ComparisonType::LessThan);
+  auto ge = std::make_shared<ComparisonExpression>(c, a, ComparisonType::GreaterThanOrEqual);
+  auto cmp_sum = std::make_shared<ComparisonExpression>(sum, a, ComparisonType::NotEqual);
+  CheckAgainstRows(*sum, chunk, batch, schema);
+  CheckAgainstRows(*lt, chunk, batch, schema);
+  CheckAgainstRows(*ge, chunk, batch, schema);
+  CheckAgainstRows(*cmp_sum, chunk, batch, schema);
+  CheckAgainstRows(LogicExpression(lt, cmp_sum, LogicType::And), chunk, batch, schema);
+  CheckAgainstRows(LogicExpression(lt, cmp_sum, LogicType::Or), chunk, batch, schema);
+
+  // strings have no kernel
+  ColumnVector result;
+  EXPECT_FALSE(d->EvaluateVector(chunk, &result));
+
+  // narrowing the selection keeps the rows where b < 3 holds
+  ASSERT_TRUE(lt->EvaluateVector(chunk, &result));
+  chunk.Select(result);
+  for (auto idx : chunk.GetSelection()) {
+    EXPECT_NE(0, idx % 7);
+    EXPECT_LT(idx % 5, 3);
+  }
+  CheckAgainstRows(*sum, chunk, batch, schema);
+  batch.Select(chunk.GetSelection());
+  EXPECT_EQ(chunk.GetSelection().size(), batch.Size());
+}
+
+}  // namespace bustub
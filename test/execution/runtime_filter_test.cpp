@@ -0,0 +1,49 @@
+/**
+ * runtime_filter_test.cpp
+ */
+
+#include <vector>
+
+#include "execution/runtime_filter.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+TEST(RuntimeFilterTest, NoFalseNegativesTest) {
+  RuntimeFilter filter;
+  EXPECT_FALSE(filter.IsBuilt());
+
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < 10000; i++) {
+    keys.push_back(i * 7 - 20000);
+  }
+  keys.push_back(INT64_MAX);
+  filter.Build(keys);
+  ASSERT_TRUE(filter.IsBuilt());
+  for (int64_t key : keys) {
+    EXPECT_TRUE(filter.MayContain(key)) << key;
+  }
+
+  // 16 bits per key leave well under 1% false positives
+  size_t false_positives = 0;
+  const size_t probes = 100000;
+  for (size_t i = 0; i < probes; i++) {
+    false_positives += filter.MayContain(100000 + static_cast<int64_t>(i)) ? 1 : 0;
+  }
+  EXPECT_LT(false_positives, probes / 100);
+
+  filter.Reset();
+  EXPECT_FALSE(filter.IsBuilt());
+}
+
+TEST(RuntimeFilterTest, EmptyBuildTest) {
+  RuntimeFilter filter;
+  filter.Build({});
+  ASSERT_TRUE(filter.IsBuilt());
+  EXPECT_EQ(0, filter.Bytes());
+  for (int64_t key = -10; key < 10; key++) {
+    EXPECT_FALSE(filter.MayContain(key));
+  }
+}
+
+}  // namespace bustub
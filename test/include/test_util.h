@@ -25,6 +25,7 @@
 #include "common/logger.h"
 #include "common/util/string_util.h"
 #include "storage/page/header_page.h"
+#include "storage/table/table_heap.h"
 
 namespace bustub {
 
@@ -92,4 +93,14 @@ auto ParseCreateStatement(const std::string &sql_base) -> std::unique_ptr<Schema
   return std::make_unique<Schema>(v);
 }
 
+/** @return the number of pages in the page chain of the table */
+auto CountPages(TableHeap *table) -> size_t {
+  size_t count = 0;
+  for (page_id_t page_id = table->GetFirstPageId(); page_id != INVALID_PAGE_ID;
+       page_id = table->GetNextPageId(page_id)) {
+    count++;
+  }
+  return count;
+}
+
 }  // namespace bustub
@@ -10,16 +10,21 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "buffer/buffer_pool_manager_instance.h"
 #include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
 #include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple_file.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
+TEST(TmpTuplePageTest, BasicTest) {
   // There are many ways to do this assignment, and this is only one of them.
   // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
   // You will get full credit as long as you are correctly using a linear probe hash table.
@@ -46,6 +51,52 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+
+  ASSERT_EQ(tmp_tuple.GetPageId(), page_id);
+  ASSERT_EQ(tmp_tuple.GetOffset(), BUSTUB_PAGE_SIZE - 8);
+  Tuple read;
+  page.Get(tmp_tuple, &read);
+  ASSERT_EQ(read.GetValue(&schema, 0).GetAs<int32_t>(), 123);
+
+  // The page takes tuples until the header is reached.
+  size_t inserted = 1;
+  while (page.Insert(tuple, &tmp_tuple)) {
+    inserted++;
+  }
+  ASSERT_EQ(inserted, (BUSTUB_PAGE_SIZE - TmpTuplePage::SIZE_TMP_TUPLE_PAGE_HEADER) / 8);
+}
+
+// NOLINTNEXTLINE
+TEST(TmpTuplePageTest, TmpTupleFileTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(4, disk_manager.get());
+
+  std::vector<Column> columns;
+  columns.emplace_back("A", TypeId::INTEGER);
+  columns.emplace_back("B", TypeId::VARCHAR, 32);
+  Schema schema(columns);
+
+  const int num_tuples = 2000;
+  TmpTupleFile file(bpm.get());
+  for (int i = 0; i < num_tuples; i++) {
+    std::vector<Value> values{ValueFactory::GetIntegerValue(i),
+                              ValueFactory::GetVarcharValue(std::string(static_cast<size_t>(i % 32), 'x'))};
+    file.Append(Tuple(values, &schema));
+  }
+  ASSERT_EQ(file.Size(), static_cast<size_t>(num_tuples));
+  ASSERT_GT(file.NumPages(), static_cast<size_t>(4));
+
+  // Tuples come back in insertion order, as often as the file is read, with only one page pinned at a time.
+  for (int pass = 0; pass < 2; pass++) {
+    file.Rewind();
+    Tuple tuple;
+    for (int i = 0; i < num_tuples; i++) {
+      ASSERT_TRUE(file.Next(&tuple));
+      ASSERT_EQ(tuple.GetValue(&schema, 0).GetAs<int32_t>(), i);
+      ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), std::string(static_cast<size_t>(i % 32), 'x'));
+    }
+    ASSERT_FALSE(file.Next(&tuple));
+  }
 }
 
 }  // namespace bustub
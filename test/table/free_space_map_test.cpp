@@ -0,0 +1,149 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_test.cpp
+//
+// Identification: test/table/free_space_map_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/table/free_space_map.h"
+#include "storage/table/table_heap.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(FreeSpaceMapTest, FindPageTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(10, disk_manager);
+  auto *map = new FreeSpaceMap(buffer_pool_manager);
+
+  // enough heap pages to fill more than one map page, all full but two
+  const page_id_t first = 1000;
+  const uint32_t count = FreeSpaceMapPage::CAPACITY + 10;
+  const page_id_t small = first + 3;
+  const page_id_t large = first + FreeSpaceMapPage::CAPACITY + 5;
+  for (uint32_t i = 0; i < count; i++) {
+    map->Update(first + i, 0);
+  }
+  map->Update(small, 100);
+  map->Update(large, 1000);
+  EXPECT_EQ(count, map->PageCount());
+
+  // free space is recorded in categories of 16 bytes, rounded down
+  EXPECT_EQ(small, map->FindPage(50));
+  EXPECT_EQ(small, map->FindPage(96));
+  EXPECT_EQ(large, map->FindPage(97));
+  EXPECT_EQ(large, map->FindPage(992));
+  EXPECT_EQ(INVALID_PAGE_ID, map->FindPage(1001));
+
+  // the target stays as long as it has room, even if an earlier page has room too
+  EXPECT_EQ(large, map->FindPage(500));
+  EXPECT_EQ(large, map->FindPage(50));
+  map->Update(large, 10);
+  EXPECT_EQ(small, map->FindPage(50));
+  map->Update(small, 0);
+  EXPECT_EQ(INVALID_PAGE_ID, map->FindPage(50));
+
+  // every map page has been unpinned
+  std::vector<page_id_t> page_ids(10);
+  for (auto &page_id : page_ids) {
+    ASSERT_NE(nullptr, buffer_pool_manager->NewPage(&page_id));
+  }
+  for (auto page_id : page_ids) {
+    buffer_pool_manager->UnpinPage(page_id, false);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete map;
+  delete buffer_pool_manager;
+  delete disk_manager;
+}
+
+// NOLINTNEXTLINE
+TEST(FreeSpaceMapTest, TableHeapReuseTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 128}}};
+  auto make_tuple = [&](int a) {
+    return Tuple{{ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(std::string(100, 'x'))}, &schema};
+  };
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(50, disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, nullptr, nullptr, transaction);
+
+  std::vector<RID> rids(1000);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_TRUE(table->InsertTuple(make_tuple(i), &rids[i], transaction));
+  }
+  const size_t pages = CountPages(table);
+  ASSERT_GT(pages, 10);
+  EXPECT_EQ(pages, table->GetFreeSpaceMap()->PageCount());
+
+  // free the third page
+  const page_id_t freed = table->GetNextPageId(table->GetNextPageId(table->GetFirstPageId()));
+  size_t deleted = 0;
+  for (const auto &rid : rids) {
+    if (rid.GetPageId() == freed) {
+      ASSERT_TRUE(table->MarkDelete(rid, transaction));
+      table->ApplyDelete(rid, transaction);
+      deleted++;
+    }
+  }
+  ASSERT_GT(deleted, 0);
+
+  // the last page is the target of this thread, so it fills up first, then the freed page takes the next tuples
+  page_id_t last = table->GetFirstPageId();
+  while (table->GetNextPageId(last) != INVALID_PAGE_ID) {
+    last = table->GetNextPageId(last);
+  }
+  RID rid;
+  do {
+    ASSERT_TRUE(table->InsertTuple(make_tuple(0), &rid, transaction));
+  } while (rid.GetPageId() == last);
+  EXPECT_EQ(freed, rid.GetPageId());
+  for (size_t i = 1; i < deleted; i++) {
+    ASSERT_TRUE(table->InsertTuple(make_tuple(static_cast<int>(i)), &rid, transaction));
+    EXPECT_EQ(freed, rid.GetPageId());
+  }
+  EXPECT_EQ(pages, CountPages(table));
+
+  // every page is full again, so the table grows at the end
+  ASSERT_TRUE(table->InsertTuple(make_tuple(0), &rid, transaction));
+  EXPECT_EQ(pages + 1, CountPages(table));
+  EXPECT_EQ(pages + 1, table->GetFreeSpaceMap()->PageCount());
+
+  // opening the table rebuilds the map from the page chain
+  auto *reopened = new TableHeap(buffer_pool_manager, nullptr, nullptr, table->GetFirstPageId());
+  EXPECT_EQ(pages + 1, reopened->GetFreeSpaceMap()->PageCount());
+  ASSERT_TRUE(reopened->InsertTuple(make_tuple(0), &rid, transaction));
+  EXPECT_EQ(pages + 1, CountPages(reopened));
+
+  // closing the table deletes the pages of its map, and a map rebuilt for the next open has every page again
+  delete reopened;
+  reopened = new TableHeap(buffer_pool_manager, nullptr, nullptr, table->GetFirstPageId());
+  EXPECT_EQ(pages + 1, reopened->GetFreeSpaceMap()->PageCount());
+  ASSERT_TRUE(reopened->InsertTuple(make_tuple(0), &rid, transaction));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  remove("test.log");
+  delete reopened;
+  delete table;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+}  // namespace bustub
@@ -0,0 +1,160 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_vacuum_test.cpp
+//
+// Identification: test/table/table_heap_vacuum_test.cpp
+//
+// Copyright (c) 2015-2022, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/page/table_page.h"
+#include "storage/table/table_heap.h"
+#include "test_util.h"  // NOLINT
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TableHeapVacuumTest, CompactTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 128}}};
+  auto make_tuple = [&](int a) {
+    return Tuple{{ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(std::string(100, 'x'))}, &schema};
+  };
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(10, disk_manager);
+  page_id_t page_id;
+  auto *page = reinterpret_cast<TablePage *>(buffer_pool_manager->NewPage(&page_id));
+  page->Init(page_id, BUSTUB_PAGE_SIZE, INVALID_PAGE_ID, nullptr, transaction);
+
+  std::vector<RID> rids(10);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(page->InsertTuple(make_tuple(i), &rids[i], transaction, nullptr, nullptr));
+  }
+  EXPECT_EQ(0, page->GetDeadSpace());
+
+  // deleting a tuple moves the tuples after it, but leaves its slot behind
+  for (int i : {3, 7, 8, 9}) {
+    ASSERT_TRUE(page->MarkDelete(rids[i], transaction, nullptr, nullptr));
+  }
+  EXPECT_TRUE(page->HasPendingDeletes());
+  for (int i : {3, 7, 8, 9}) {
+    page->ApplyDelete(rids[i], transaction, nullptr);
+  }
+  EXPECT_FALSE(page->HasPendingDeletes());
+
+  // the three slots at the end go, the one in the middle stays for the next insert
+  const uint32_t free_space = page->GetFreeSpaceRemaining();
+  const uint32_t dead_space = page->GetDeadSpace();
+  EXPECT_EQ(3 * (sizeof(uint32_t) * 2), dead_space);
+  EXPECT_EQ(dead_space, page->Compact());
+  EXPECT_EQ(free_space + dead_space, page->GetFreeSpaceRemaining());
+  EXPECT_EQ(0, page->GetDeadSpace());
+  for (int i : {0, 1, 2, 4, 5, 6}) {
+    Tuple tuple;
+    ASSERT_TRUE(page->GetTuple(rids[i], &tuple, transaction, nullptr));
+    EXPECT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  RID rid;
+  ASSERT_TRUE(page->InsertTuple(make_tuple(3), &rid, transaction, nullptr, nullptr));
+  EXPECT_EQ(rids[3], rid);
+
+  buffer_pool_manager->UnpinPage(page_id, true);
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapVacuumTest, ReleasePagesTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 128}}};
+  auto make_tuple = [&](int a) {
+    return Tuple{{ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(std::string(100, 'x'))}, &schema};
+  };
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(50, disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, nullptr, nullptr, transaction);
+
+  std::vector<RID> rids(1000);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_TRUE(table->InsertTuple(make_tuple(i), &rids[i], transaction));
+  }
+  const size_t pages = CountPages(table);
+
+  // keep one tuple in ten
+  std::unordered_map<int, RID> live;
+  for (int i = 0; i < 1000; i++) {
+    if (i % 10 == 0) {
+      live[i] = rids[i];
+      continue;
+    }
+    ASSERT_TRUE(table->MarkDelete(rids[i], transaction));
+    table->ApplyDelete(rids[i], transaction);
+  }
+
+  // a running transaction wrote a tuple on this page, so it keeps its tuples, though it may take those of others
+  const page_id_t busy_page = live[500].GetPageId();
+  size_t moves = 0;
+  auto stats = table->Vacuum(transaction, {busy_page}, [&](const Tuple &tuple, const RID &old_rid, const RID &new_rid) {
+    int a = tuple.GetValue(&schema, 0).GetAs<int32_t>();
+    EXPECT_EQ(live[a], old_rid);
+    EXPECT_NE(busy_page, old_rid.GetPageId());
+    EXPECT_NE(old_rid.GetPageId(), new_rid.GetPageId());
+    live[a] = new_rid;
+    moves++;
+  });
+  EXPECT_EQ(moves, stats.moved_tuples_);
+  EXPECT_GT(stats.released_pages_, 0);
+  EXPECT_LT(CountPages(table), pages);
+  EXPECT_EQ(CountPages(table), table->GetFreeSpaceMap()->PageCount());
+  EXPECT_EQ(busy_page, live[500].GetPageId());
+
+  // every tuple is where the callback said it went, and the scan sees each once
+  for (const auto &[a, rid] : live) {
+    Tuple tuple;
+    ASSERT_TRUE(table->GetTuple(rid, &tuple, transaction));
+    EXPECT_EQ(a, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  size_t scanned = 0;
+  for (auto it = table->Begin(transaction); it != table->End(); ++it) {
+    scanned++;
+  }
+  EXPECT_EQ(live.size(), scanned);
+
+  // nothing is left to do
+  stats = table->Vacuum(transaction, {}, [](const Tuple &, const RID &, const RID &) {});
+  EXPECT_EQ(0, stats.moved_tuples_);
+  EXPECT_EQ(0, stats.released_pages_);
+
+  // every page has been unpinned
+  std::vector<page_id_t> page_ids(50);
+  for (auto &page_id : page_ids) {
+    ASSERT_NE(nullptr, buffer_pool_manager->NewPage(&page_id));
+  }
+  for (auto page_id : page_ids) {
+    buffer_pool_manager->UnpinPage(page_id, false);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  remove("test.log");
+  delete table;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+}  // namespace bustub
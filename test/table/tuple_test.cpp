@@ -17,10 +17,14 @@
 #include <vector>
 
 #include "buffer/buffer_pool_manager_instance.h"
+#include "concurrency/transaction_manager.h"
+#include "execution/tuple_batch.h"
 #include "gtest/gtest.h"
 #include "logging/common.h"
 #include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 // NOLINTNEXTLINE
@@ -71,4 +75,157 @@ TEST(TupleTest, DISABLED_TableHeapTest) {
   delete disk_manager;
 }
 
+// NOLINTNEXTLINE
+TEST(TupleTest, MoveAndBatchTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::INTEGER}}};
+  auto make_tuple = [&](int a) {
+    return Tuple{{ValueFactory::GetIntegerValue(a), ValueFactory::GetIntegerValue(a * 10)}, &schema};
+  };
+
+  // moving hands over the buffer and leaves an empty tuple behind
+  Tuple source = make_tuple(1);
+  const char *data = source.GetData();
+  Tuple moved{std::move(source)};
+  EXPECT_EQ(data, moved.GetData());
+  EXPECT_EQ(nullptr, source.GetData());  // NOLINT
+  EXPECT_EQ(0, source.GetLength());      // NOLINT
+
+  // copying into a tuple of the same length keeps its buffer
+  Tuple copy = make_tuple(2);
+  data = copy.GetData();
+  copy = moved;
+  EXPECT_EQ(data, copy.GetData());
+  EXPECT_EQ(1, copy.GetValue(&schema, 0).GetAs<int32_t>());
+
+  TupleBatch batch(4);
+  for (int i = 0; i < 4; i++) {
+    batch.Append(make_tuple(i), RID(0, i));
+  }
+  EXPECT_TRUE(batch.IsFull());
+  batch.Retain([&](const Tuple &tuple) { return tuple.GetValue(&schema, 0).GetAs<int32_t>() % 2 == 1; });
+  ASSERT_EQ(2, batch.Size());
+  EXPECT_EQ(1, batch.GetTuple(0).GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ(3, batch.GetTuple(1).GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ(RID(0, 3), batch.GetRid(1));
+
+  batch.Reset();
+  EXPECT_TRUE(batch.IsEmpty());
+  EXPECT_EQ(4, batch.Capacity());
+}
+
+// NOLINTNEXTLINE
+TEST(TupleTest, TupleViewTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 8}}};
+  auto *transaction = new Transaction(0);
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(10, disk_manager);
+  auto *table = new TableHeap(buffer_pool_manager, nullptr, nullptr, transaction);
+
+  std::vector<RID> rids(3);
+  for (int i = 0; i < 3; i++) {
+    Tuple tuple{{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(i + 1, 'x'))}, &schema};
+    ASSERT_TRUE(table->InsertTuple(tuple, &rids[i], transaction));
+  }
+  ASSERT_TRUE(table->MarkDelete(rids[1], transaction));
+
+  {
+    TablePageGuard guard = table->PinPage(table->GetFirstPageId());
+    TablePage *page = guard.GetPage();
+    page->RLatch();
+    // the view points into the page instead of a copy
+    TupleView view;
+    ASSERT_TRUE(page->GetTupleView(rids[2], &view));
+    EXPECT_GE(view.GetData(), page->GetData());
+    EXPECT_LT(view.GetData(), page->GetData() + BUSTUB_PAGE_SIZE);
+    EXPECT_EQ(rids[2], view.GetRid());
+    EXPECT_EQ(2, view.GetValue(&schema, 0).GetAs<int32_t>());
+    EXPECT_EQ("xxx", view.GetValue(&schema, 1).ToString());
+    EXPECT_FALSE(page->GetTupleView(rids[1], &view));
+
+    // materializing copies the bytes, into the buffer of a batch slot if the length fits
+    Tuple copy = view.Materialize();
+    EXPECT_NE(view.GetData(), copy.GetData());
+    EXPECT_EQ("xxx", copy.GetValue(&schema, 1).ToString());
+    TupleBatch batch(1);
+    batch.Append(copy, RID());
+    const char *slot = batch.GetTuple(0).GetData();
+    batch.Reset();
+    batch.Append(view);
+    EXPECT_EQ(slot, batch.GetTuple(0).GetData());
+    EXPECT_EQ(rids[2], batch.GetRid(0));
+    page->RUnlatch();
+  }
+
+  // the guard unpinned the page, so every frame can be used for other pages again
+  std::vector<page_id_t> page_ids(10);
+  for (auto &page_id : page_ids) {
+    ASSERT_NE(nullptr, buffer_pool_manager->NewPage(&page_id));
+  }
+  for (auto page_id : page_ids) {
+    buffer_pool_manager->UnpinPage(page_id, false);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  remove("test.log");
+  delete table;
+  delete buffer_pool_manager;
+  delete disk_manager;
+  delete transaction;
+}
+
+// NOLINTNEXTLINE
+TEST(TupleTest, InsertBatchOutOfPagesTest) {
+  Schema schema{std::vector<Column>{Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 1000}}};
+  auto *disk_manager = new DiskManager("test.db");
+  auto *buffer_pool_manager = new BufferPoolManagerInstance(5, disk_manager);
+  auto *lock_manager = new LockManager();
+  auto *txn_manager = new TransactionManager(lock_manager);
+  auto *transaction = txn_manager->Begin();
+  auto *table = new TableHeap(buffer_pool_manager, lock_manager, nullptr, transaction);
+
+  // take every frame but one, which the last page of the table gets, so that no page can be appended
+  std::vector<page_id_t> page_ids;
+  page_id_t page_id;
+  while (buffer_pool_manager->NewPage(&page_id) != nullptr) {
+    page_ids.push_back(page_id);
+  }
+  buffer_pool_manager->UnpinPage(page_ids.back(), false);
+  page_ids.pop_back();
+
+  std::vector<Tuple> tuples;
+  for (int i = 0; i < 10; i++) {
+    tuples.emplace_back(
+        std::vector<Value>{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::string(1000, 'x'))},
+        &schema);
+  }
+  std::vector<RID> rids;
+  EXPECT_FALSE(table->InsertTuples(tuples, &rids, transaction));
+  EXPECT_EQ(TransactionState::ABORTED, transaction->GetState());
+
+  // the tuples that did fit are in the write set, and aborting removes them
+  ASSERT_GT(rids.size(), 0);
+  ASSERT_LT(rids.size(), tuples.size());
+  ASSERT_EQ(rids.size(), transaction->GetWriteSet()->size());
+  for (size_t i = 0; i < rids.size(); i++) {
+    EXPECT_EQ(rids[i], (*transaction->GetWriteSet())[i].rid_);
+    EXPECT_EQ(WType::INSERT, (*transaction->GetWriteSet())[i].wtype_);
+  }
+  txn_manager->Abort(transaction);
+  for (auto id : page_ids) {
+    buffer_pool_manager->UnpinPage(id, false);
+  }
+  EXPECT_EQ(table->End(), table->Begin(transaction));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  remove("test.log");
+  delete table;
+  delete transaction;
+  delete txn_manager;
+  delete lock_manager;
+  delete buffer_pool_manager;
+  delete disk_manager;
+}
+
 }  // namespace bustub
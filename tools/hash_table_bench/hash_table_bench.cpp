@@ -0,0 +1,125 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/config.h"
+#include "container/hash/extendible_hash_table.h"
+#include "container/hash/hash_table.h"
+#include "container/hash/open_addressing_hash_table.h"
+#include "fmt/core.h"
+
+#include <sys/time.h>
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_BENCH_KEYS = 10000;
+static const size_t BUSTUB_BENCH_THREAD = 4;
+static const uint64_t BUSTUB_BENCH_DURATION_MS = 2000;
+/** One in every BUSTUB_BENCH_EVICT_RATIO operations evicts a page: it removes a key and inserts a new one. */
+static const uint64_t BUSTUB_BENCH_EVICT_RATIO = 10;
+
+/**
+ * Replay a buffer-pool page-table workload: mostly lookups of resident pages, plus an occasional eviction that swaps
+ * one resident page id for a new one. Returns the number of operations per second over all threads.
+ */
+auto RunWorkload(bustub::HashTable<bustub::page_id_t, bustub::frame_id_t> *table, size_t num_keys, size_t num_threads,
+                 uint64_t duration_ms) -> double {
+  for (size_t i = 0; i < num_keys; i++) {
+    table->Insert(static_cast<bustub::page_id_t>(i), static_cast<bustub::frame_id_t>(i));
+  }
+
+  std::atomic<uint64_t> total_ops{0};
+  std::vector<std::thread> threads;
+  auto start = ClockMs();
+  for (size_t tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid]() {
+      std::mt19937 gen(tid);
+      // Every thread owns the keys congruent to its id, so evictions never race on the same page id.
+      std::uniform_int_distribution<size_t> dis(0, num_keys / num_threads - 1);
+      std::vector<bustub::page_id_t> owned;
+      for (size_t key = tid; key < num_keys; key += num_threads) {
+        owned.push_back(static_cast<bustub::page_id_t>(key));
+      }
+      auto next_page_id = static_cast<bustub::page_id_t>(num_keys + tid);
+      uint64_t ops = 0;
+      bustub::frame_id_t frame_id;
+      while (ClockMs() - start < duration_ms) {
+        for (int i = 0; i < 1000; i++, ops++) {
+          auto slot = dis(gen);
+          if (ops % BUSTUB_BENCH_EVICT_RATIO == 0) {
+            table->Remove(owned[slot]);
+            table->Insert(next_page_id, static_cast<bustub::frame_id_t>(slot));
+            owned[slot] = next_page_id;
+            next_page_id += static_cast<bustub::page_id_t>(num_threads);
+          } else {
+            table->Find(owned[slot], frame_id);
+          }
+        }
+      }
+      total_ops += ops;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto elapsed = ClockMs() - start;
+  return static_cast<double>(total_ops) / static_cast<double>(elapsed) * 1000;
+}
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-hash-table-bench");
+  program.add_argument("--duration").help("run each table for n milliseconds");
+  program.add_argument("--threads").help("number of worker threads");
+  program.add_argument("--keys").help("number of resident page ids");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t duration_ms = BUSTUB_BENCH_DURATION_MS;
+  size_t num_threads = BUSTUB_BENCH_THREAD;
+  size_t num_keys = BUSTUB_BENCH_KEYS;
+  if (program.present("--duration")) {
+    duration_ms = std::stoul(program.get("--duration"));
+  }
+  if (program.present("--threads")) {
+    num_threads = std::stoul(program.get("--threads"));
+  }
+  if (program.present("--keys")) {
+    num_keys = std::stoul(program.get("--keys"));
+  }
+  if (num_threads == 0 || num_keys < num_threads) {
+    std::cerr << "need at least one thread and one key per thread" << std::endl;
+    return 1;
+  }
+
+  fmt::print("{} threads, {} keys, {} ms per table\n", num_threads, num_keys, duration_ms);
+
+  {
+    auto table = std::make_unique<bustub::ExtendibleHashTable<bustub::page_id_t, bustub::frame_id_t>>(4);
+    auto ops = RunWorkload(table.get(), num_keys, num_threads, duration_ms);
+    fmt::print("extendible (list buckets): {:.0f} ops/s\n", ops);
+  }
+  {
+    auto table = std::make_unique<bustub::OpenAddressingHashTable<bustub::page_id_t, bustub::frame_id_t>>(num_keys);
+    auto ops = RunWorkload(table.get(), num_keys, num_threads, duration_ms);
+    fmt::print("open addressing (striped): {:.0f} ops/s\n", ops);
+  }
+
+  return 0;
+}
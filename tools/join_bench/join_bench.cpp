@@ -0,0 +1,73 @@
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "fmt/core.h"
+
+#include <sys/time.h>
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_BENCH_REPEAT = 3;
+
+/** Equi-join of two 1M-row mock tables; every key appears twice on each side. */
+static const char *BUSTUB_BENCH_QUERY =
+    "SELECT count(*), max(__mock_t4_1m.y), max(__mock_t5_1m.y) FROM __mock_t4_1m, __mock_t5_1m "
+    "WHERE __mock_t4_1m.x = __mock_t5_1m.x";
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-join-bench");
+  program.add_argument("--repeat").help("run the query n times");
+  program.add_argument("--query").help("the join query to run instead of the default one");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t repeat = BUSTUB_BENCH_REPEAT;
+  std::string query = BUSTUB_BENCH_QUERY;
+  if (program.present("--repeat")) {
+    repeat = std::stoul(program.get("--repeat"));
+  }
+  if (program.present("--query")) {
+    query = program.get("--query");
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub->GenerateMockTable();
+
+  {
+    std::stringstream ss;
+    auto writer = bustub::SimpleStreamWriter(ss);
+    bustub->ExecuteSql("EXPLAIN " + query, writer);
+    fmt::print("{}\n", ss.str());
+  }
+
+  uint64_t total_ms = 0;
+  for (size_t i = 0; i < repeat; i++) {
+    std::stringstream ss;
+    auto writer = bustub::SimpleStreamWriter(ss, true);
+    auto start = ClockMs();
+    bustub->ExecuteSql(query, writer);
+    auto elapsed = ClockMs() - start;
+    total_ms += elapsed;
+    fmt::print("run {}: {} ms, result: {}", i, elapsed, ss.str());
+  }
+  if (repeat > 0) {
+    fmt::print("average: {} ms\n", total_ms / repeat);
+  }
+
+  return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "common/util/string_util.h"
+#include "fmt/core.h"
+
+#include <sys/time.h>
+
+auto ClockMs() -> uint64_t {
+  struct timeval tm;
+  gettimeofday(&tm, nullptr);
+  return static_cast<uint64_t>(tm.tv_sec * 1000) + static_cast<uint64_t>(tm.tv_usec / 1000);
+}
+
+static const size_t BUSTUB_BENCH_REPEAT = 3;
+
+static const char *BUSTUB_BENCH_THREADS = "1,2,4,8";
+
+/** The table is filled from a 50k-row mock table; the query filters and aggregates all of it. */
+static const char *BUSTUB_BENCH_SOURCE = "__mock_t1_50k";
+
+static const char *BUSTUB_BENCH_QUERY = "SELECT count(*), max(y), min(x) FROM bench WHERE x > 1000 AND y < 40000000";
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-scan-bench");
+  program.add_argument("--repeat").help("run the query n times for each thread count");
+  program.add_argument("--threads").help("comma-separated scan thread counts to run the query with");
+  program.add_argument("--source").help("the mock table to copy into the scanned table");
+  program.add_argument("--query").help("the query to run over table `bench` instead of the default one");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  size_t repeat = BUSTUB_BENCH_REPEAT;
+  std::string threads = BUSTUB_BENCH_THREADS;
+  std::string source = BUSTUB_BENCH_SOURCE;
+  std::string query = BUSTUB_BENCH_QUERY;
+  if (program.present("--repeat")) {
+    repeat = std::stoul(program.get("--repeat"));
+  }
+  if (program.present("--threads")) {
+    threads = program.get("--threads");
+  }
+  if (program.present("--source")) {
+    source = program.get("--source");
+  }
+  if (program.present("--query")) {
+    query = program.get("--query");
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub->GenerateMockTable();
+
+  {
+    std::stringstream ss;
+    auto writer = bustub::SimpleStreamWriter(ss, true);
+    bustub->ExecuteSql("CREATE TABLE bench(x int, y int);", writer);
+    ss.str("");
+    auto start = ClockMs();
+    bustub->ExecuteSql(fmt::format("INSERT INTO bench SELECT * FROM {};", source), writer);
+    fmt::print("loaded {} in {} ms, rows: {}", source, ClockMs() - start, ss.str());
+  }
+
+  uint64_t serial_ms = 0;
+  for (const auto &thread_count : bustub::StringUtil::Split(threads, ',')) {
+    std::stringstream ss;
+    auto writer = bustub::SimpleStreamWriter(ss, true);
+    bustub->ExecuteSql(fmt::format("SET scan_threads={};", thread_count), writer);
+
+    uint64_t total_ms = 0;
+    for (size_t i = 0; i < repeat; i++) {
+      std::stringstream result;
+      auto result_writer = bustub::SimpleStreamWriter(result, true);
+      auto start = ClockMs();
+      bustub->ExecuteSql(query, result_writer);
+      auto elapsed = ClockMs() - start;
+      total_ms += elapsed;
+      fmt::print("threads {} run {}: {} ms, result: {}", thread_count, i, elapsed, result.str());
+    }
+    if (repeat == 0) {
+      continue;
+    }
+    auto average_ms = total_ms / repeat;
+    if (serial_ms == 0) {
+      serial_ms = average_ms;
+    }
+    fmt::print("threads {}: average {} ms, speedup {:.2f}x\n", thread_count, average_ms,
+               average_ms == 0 ? 0.0 : static_cast<double>(serial_ms) / static_cast<double>(average_ms));
+  }
+
+  return 0;
+}
@@ -2,6 +2,7 @@
 #include <ios>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -60,10 +61,50 @@ auto ResultCompare(const std::string &produced_result, const std::string &expect
   return cmp_result;
 }
 
+/**
+ * Sum up a counter over the nodes of an EXPLAIN ANALYZE output, where a node prints its counters as
+ * `Node { ... } | name=value, name=value`. A node that did not record the counter counts as 0.
+ */
+auto SumStat(const std::string &analyzed, const std::string &name) -> int64_t {
+  int64_t sum = 0;
+  for (const auto &line : SplitLines(analyzed)) {
+    auto pos = line.find(" | ");
+    if (pos == std::string::npos) {
+      continue;
+    }
+    for (const auto &stat : bustub::StringUtil::Split(line.substr(pos + 3), ", ")) {
+      auto eq = stat.find('=');
+      if (eq != std::string::npos && stat.substr(0, eq) == name) {
+        sum += std::stoll(stat.substr(eq + 1));
+      }
+    }
+  }
+  return sum;
+}
+
 auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instance,
                          const std::vector<std::string> &extra_options, bool verbose) -> bool {
+  std::optional<std::string> analyzed;
   for (const auto &opt : extra_options) {
-    if (bustub::StringUtil::StartsWith(opt, "ensure:")) {
+    if (bustub::StringUtil::StartsWith(opt, "ensure:stat:")) {
+      // `ensure:stat:name` wants the counter above zero, `ensure:stat:name=n` wants it to be n. The query runs once
+      // more for all these checks together, so DML under them has to give the same counters when repeated.
+      if (!analyzed.has_value()) {
+        std::stringstream result;
+        auto writer = bustub::SimpleStreamWriter(result);
+        instance.ExecuteSql("explain (analyze) " + sql, writer);
+        analyzed = result.str();
+      }
+
+      auto stat = opt.substr(std::string("ensure:stat:").size());
+      auto eq = stat.find('=');
+      auto name = stat.substr(0, eq);
+      int64_t sum = SumStat(*analyzed, name);
+      if (eq == std::string::npos ? sum <= 0 : sum != std::stoll(stat.substr(eq + 1))) {
+        fmt::print("{}={} does not match {}\n", name, sum, opt);
+        return false;
+      }
+    } else if (bustub::StringUtil::StartsWith(opt, "ensure:")) {
       std::stringstream result;
       auto writer = bustub::SimpleStreamWriter(result);
       instance.ExecuteSql("explain " + sql, writer);
@@ -88,6 +129,32 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("NestedIndexJoin not found\n");
           return false;
         }
+      } else if (opt == "ensure:hash_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "HashJoin")) {
+          fmt::print("HashJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:merge_join") {
+        if (!bustub::StringUtil::Contains(result.str(), "MergeJoin")) {
+          fmt::print("MergeJoin not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:scan_limit") {
+        // Only scans print the limit after another field; a Limit node prints `Limit { limit=n }`.
+        if (!bustub::StringUtil::Contains(result.str(), ", limit=")) {
+          fmt::print("scan with a limit not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:runtime_filter") {
+        if (!bustub::StringUtil::Contains(result.str(), "runtime_filter=")) {
+          fmt::print("runtime filter not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:gather") {
+        if (!bustub::StringUtil::Contains(result.str(), "Gather")) {
+          fmt::print("Gather not found\n");
+          return false;
+        }
       } else {
         throw bustub::NotImplementedException(fmt::format("unsupported extra option: {}", opt));
       }